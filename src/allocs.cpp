@@ -0,0 +1,54 @@
+#include "allocs.h"
+
+#include <format>
+#include <iterator>
+
+ScrollerAllocs scroller_allocs;
+
+void ScrollerAllocs::reset()
+{
+    subsystems.fill(Data {});
+    scroller_stats.reset_allocations();
+}
+
+std::string ScrollerAllocs::check() const
+{
+    if (!enabled)
+        return "scroller: allocation accounting is off, turn it on with allocs on";
+
+    std::string failed;
+    for (auto name : steady_operations) {
+        const StatsOperation *operation = scroller_stats.get(name);
+        if (operation->allocations > 0)
+            failed += std::format("{}: {} allocations, {} bytes in {} calls\n", name, operation->allocations,
+                                  operation->allocated, operation->latency.get_count());
+    }
+    return failed.empty() ? "ok" : "failed\n" + failed;
+}
+
+std::string ScrollerAllocs::report(bool json) const
+{
+    static const char *names[] = { "ListNode", "Row", "Column", "Window", "Events", "Rules", "Jump" };
+    static_assert(std::size(names) == size_t(AllocSubsystem::Count));
+
+    std::string out;
+    if (json) {
+        out = std::format("{{\"enabled\": {}, \"subsystems\": [", enabled);
+        for (size_t i = 0; i < subsystems.size(); ++i) {
+            const auto &data = subsystems[i];
+            out += std::format("{}\n  {{\"name\": \"{}\", \"allocations\": {}, \"frees\": {}, \"bytes\": {}, \"freed\": {}}}",
+                               i == 0 ? "" : ",", names[i], data.allocations, data.frees, data.bytes, data.freed);
+        }
+        out += "\n], \"operations\": " + scroller_stats.report_allocations(true) + "}\n";
+    } else {
+        out = std::format("accounting: {}\n\n", enabled ? "on" : "off");
+        out += std::format("{:<36}{:>14}{:>10}{:>14}{:>14}\n", "subsystem", "allocations", "frees", "bytes", "net bytes");
+        for (size_t i = 0; i < subsystems.size(); ++i) {
+            const auto &data = subsystems[i];
+            out += std::format("{:<36}{:>14}{:>10}{:>14}{:>14}\n", names[i], data.allocations, data.frees, data.bytes,
+                               int64_t(data.bytes) - int64_t(data.freed));
+        }
+        out += "\n" + scroller_stats.report_allocations(false);
+    }
+    return out;
+}
@@ -0,0 +1,112 @@
+#ifndef SCROLLER_ALLOCS_H
+#define SCROLLER_ALLOCS_H
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "stats.h"
+
+// Parts of the plugin whose heap use we account for
+enum class AllocSubsystem {
+    ListNode,   // nodes of the row, column and window lists
+    Row,
+    Column,
+    Window,
+    Events,     // IPC event strings
+    Rules,      // window rule parsing
+    Jump,       // window and label vectors of scroller:jump
+    Count
+};
+
+// Opt-in heap accounting. Objects are counted by class-specific operator
+// new/delete (AllocCounted), the nodes of the row, column and window lists
+// by their Heap (LayoutHeap), strings and vectors at the places that build
+// them. Every allocation is also attributed to the running StatsOperation.
+class ScrollerAllocs {
+public:
+    ScrollerAllocs() : enabled(false) {}
+    ~ScrollerAllocs() {}
+
+    bool is_enabled() const { return enabled; }
+    void set_enabled(bool enable) { enabled = enable; }
+    void reset();
+    std::string report(bool json) const;
+    // "ok", or the steady operations that allocated since the last reset
+    std::string check() const;
+
+    void add(AllocSubsystem subsystem, size_t bytes) {
+        if (!enabled)
+            return;
+        auto &data = subsystems[size_t(subsystem)];
+        ++data.allocations;
+        data.bytes += bytes;
+        scroller_stats.count_allocation(bytes);
+    }
+    void remove(AllocSubsystem subsystem, size_t bytes) {
+        if (!enabled)
+            return;
+        auto &data = subsystems[size_t(subsystem)];
+        ++data.frees;
+        data.freed += bytes;
+    }
+    // A string allocates when it doesn't fit in its internal buffer
+    void add_string(AllocSubsystem subsystem, const std::string &str) {
+        if (enabled && str.capacity() > std::string().capacity())
+            add(subsystem, str.capacity() + 1);
+    }
+    // Estimates the allocations of a vector grown from empty by push_back(),
+    // which doubles its capacity every time it is full.
+    template <typename T>
+    void add_vector(AllocSubsystem subsystem, const std::vector<T> &v) {
+        if (!enabled || v.capacity() == 0)
+            return;
+        const size_t growths = std::bit_width(v.capacity());
+        auto &data = subsystems[size_t(subsystem)];
+        data.allocations += growths;
+        data.frees += growths - 1;
+        const size_t bytes = (2 * std::bit_ceil(v.capacity()) - 1) * sizeof(T);
+        data.bytes += bytes;
+        data.freed += bytes - v.capacity() * sizeof(T);
+        scroller_stats.count_allocation(bytes, growths);
+    }
+
+private:
+    struct Data {
+        uint64_t allocations = 0;
+        uint64_t frees = 0;
+        uint64_t bytes = 0;
+        uint64_t freed = 0;
+    };
+
+    bool enabled;
+    std::array<Data, size_t(AllocSubsystem::Count)> subsystems;
+};
+
+extern ScrollerAllocs scroller_allocs;
+
+// Base for the classes whose instances we account for
+template <AllocSubsystem S>
+class AllocCounted {
+public:
+    static void *operator new(size_t size) {
+        scroller_allocs.add(S, size);
+        return ::operator new(size);
+    }
+    static void operator delete(void *ptr, size_t size) {
+        scroller_allocs.remove(S, size);
+        ::operator delete(ptr);
+    }
+};
+
+// Heap of the lists of rows, columns and windows
+struct LayoutHeap {
+    static void allocated(size_t size) { scroller_allocs.add(AllocSubsystem::ListNode, size); }
+    static void freed(size_t size) { scroller_allocs.remove(AllocSubsystem::ListNode, size); }
+};
+
+#endif // SCROLLER_ALLOCS_H
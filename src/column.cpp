@@ -10,7 +10,7 @@ extern std::function<SDispatchResult(std::string)> orig_moveFocusTo;
 extern ScrollerSizes scroller_sizes;
 
 Column::Column(PHLWINDOW cwindow, const Row *row)
-    : reorder(Reorder::Auto), row(row)
+    : reorder(Reorder::Auto), stacked(false), row(row)
 {
     width = scroller_sizes.get_column_default_width(cwindow);
     const Box &max = row->get_max();
@@ -30,7 +30,7 @@ Column::Column(PHLWINDOW cwindow, const Row *row)
 }
 
 Column::Column(Window *window, StandardSize width, double maxw, const Row *row)
-    : width(width), reorder(Reorder::Auto), row(row)
+    : width(width), reorder(Reorder::Auto), stacked(false), row(row)
 {
     const Box &max = row->get_max();
     windows.push_back(window);
@@ -38,15 +38,15 @@ Column::Column(Window *window, StandardSize width, double maxw, const Row *row)
     update_width(width, maxw);
 }
 
-Column::Column(const Row *pRow, const Column *column, List<Window *> &pWindows)
+Column::Column(const Row *pRow, const Column *column, List<Window *, LayoutHeap> &pWindows)
 {
     width = column->width;
     reorder = column->reorder;
+    stacked = column->stacked;
     geom = column->geom;
     mem = column->mem;
-    for (auto win = pWindows.first(); win != nullptr; win = win->next()) {
-        windows.push_back(win->data());
-    }
+    // Takes the nodes, pWindows is left empty
+    windows.splice_after(windows.last(), pWindows);
     active = windows.first();
     name = column->name;
     row = pRow;
@@ -60,6 +60,19 @@ Column::~Column()
     windows.clear();
 }
 
+void Column::get_usage(RowUsage &usage) const
+{
+    ++usage.columns;
+    usage.bytes += sizeof(Column);
+    if (name.capacity() > std::string().capacity())
+        usage.bytes += name.capacity() + 1;
+    for (auto win = windows.first(); win != nullptr; win = win->next()) {
+        ++usage.nodes;
+        usage.bytes += sizeof(ListNode<Window *>);
+        win->data()->get_usage(usage);
+    }
+}
+
 bool Column::has_window(PHLWINDOW window) const
 {
     for (auto win = windows.first(); win != nullptr; win = win->next()) {
@@ -127,8 +140,9 @@ void Column::remove_window(PHLWINDOW window)
             }
             if (row->get_pinned_column() == this)
                 win->data()->pin(false);
+            Window *w = win->data();
             windows.erase(win);
-            delete win->data();
+            delete w;
             return;
         }
     }
@@ -148,6 +162,18 @@ void Column::focus_window(PHLWINDOW window)
 void Column::recalculate_col_geometry(const Vector2D &gap_x, double gap, bool animate)
 {
     const Box &max = row->get_max();
+    if (stacked) {
+        for (auto w = windows.first(); w != nullptr; w = w->next()) {
+            w->data()->set_stacked(true, max.h);
+            w->data()->set_geom_h(max.h);
+        }
+        recalculate_col_geometry_stacked(gap_x, max.y, animate);
+        return;
+    }
+    // Windows coming from a stacked column recover their heights
+    for (auto w = windows.first(); w != nullptr; w = w->next()) {
+        w->data()->set_stacked(false, max.h);
+    }
     // In theory, every window in the Columm should have the same size,
     // but the standard layouts don't follow this rule (to make the code
     // simpler?). Windows close to the border of the monitor will have
@@ -269,10 +295,38 @@ void Column::recalculate_col_geometry(const Vector2D &gap_x, double gap, bool an
 // Recalculates the geometry of the windows in the column for overview mode
 void Column::recalculate_col_geometry_overview(const Vector2D &gap_x, double gap)
 {
+    if (stacked) {
+        recalculate_col_geometry_stacked(gap_x, geom.vy, true);
+        return;
+    }
     windows.first()->data()->move_to_pos(geom.x, geom.vy, gap_x, 0.0);
     adjust_windows(windows.first(), gap_x, gap, true);
 }
 
+// Only the active window is configured, the rest stay hidden. Switching tabs
+// then only touches the window being hidden and the one being shown.
+void Column::recalculate_col_geometry_stacked(const Vector2D &gap_x, double y, bool animate)
+{
+    std::vector<PHLWINDOWREF> tabs;
+    size_t index = 0;
+    for (auto w = windows.first(); w != nullptr; w = w->next()) {
+        if (w == active)
+            index = tabs.size();
+        tabs.push_back(w->data()->get_window());
+        w->data()->set_stack_hidden(w != active);
+    }
+    Window *window = active->data();
+    window->set_stack_tabs(tabs, index);
+    window->move_to_pos(geom.x, y, gap_x, 0.0);
+    window->update_window(geom.w, gap_x, 0.0, 0.0, animate);
+}
+
+void Column::toggle_stacked()
+{
+    reorder = Reorder::Auto;
+    stacked = !stacked;
+}
+
 void Column::move_active_up()
 {
     if (active == windows.first())
@@ -456,6 +510,9 @@ void Column::update_width(StandardSize cwidth, double maxw, bool internal_too)
 
 void Column::fit_size(FitSize fitsize, const Vector2D &gap_x, double gap)
 {
+    // Stacked windows already take the full height
+    if (stacked)
+        return;
     const Box &max = row->get_max();
     reorder = Reorder::Auto;
     ListNode<Window *> *from, *to;
@@ -501,6 +558,33 @@ void Column::fit_size(FitSize fitsize, const Vector2D &gap_x, double gap)
         from = windows.first();
         to = active;
         break;
+    case FitSize::Selection: {
+        // The windows from the first to the last selected one, including
+        // any unselected between them, share the height of the screen
+        from = to = nullptr;
+        for (auto w = windows.first(); w != nullptr; w = w->next()) {
+            if (!w->data()->is_selected())
+                continue;
+            if (from == nullptr)
+                from = w;
+            to = w;
+        }
+        if (from == nullptr)
+            return;
+        double total = 0.0;
+        for (auto w = from; w != to->next(); w = w->next()) {
+            total += w->data()->get_geom_h();
+        }
+        for (auto w = from; w != to->next(); w = w->next()) {
+            Window *win = w->data();
+            win->set_height_free();
+            win->set_geom_h(win->get_geom_h() / total * max.h);
+        }
+        auto gap0 = from == windows.first() ? 0.0 : gap;
+        from->data()->move_to_top(geom.x, max, gap_x, gap0);
+        adjust_windows(from, gap_x, gap, true);
+        return;
+    }
     default:
         return;
     }
@@ -524,24 +608,29 @@ void Column::fit_size(FitSize fitsize, const Vector2D &gap_x, double gap)
     }
 }
 
-void Column::cycle_size_active_window(int step, const Vector2D &gap_x, double gap)
+StandardSize Column::next_window_height(Window *window, int step) const
 {
-    reorder = Reorder::Auto;
-    StandardSize height = active->data()->get_height();
+    StandardSize height = window->get_height();
     if (height == StandardSize::Free) {
 
         // When cycle-resizing from Free mode, move back to closest or default
         static auto* const *CYCLESIZE_CLOSEST = (Hyprlang::INT* const *)HyprlandAPI::getConfigValue(PHANDLE, "plugin:scroller:cyclesize_closest")->getDataStaticPtr();
         if (**CYCLESIZE_CLOSEST) {
-            double fraction = active->data()->get_geom_h() / row->get_max().h;
+            double fraction = window->get_geom_h() / row->get_max().h;
             height = scroller_sizes.get_window_closest_height(g_pCompositor->m_lastMonitor, fraction, step);
         } else {
-            height = scroller_sizes.get_window_default_height(active->data()->get_window());
+            height = scroller_sizes.get_window_default_height(window->get_window());
         }
     } else {
         height = scroller_sizes.get_next_window_height(height, step);
     }
-    active->data()->update_height(height, row->get_max().h);
+    return height;
+}
+
+void Column::cycle_size_active_window(int step, const Vector2D &gap_x, double gap)
+{
+    reorder = Reorder::Auto;
+    active->data()->update_height(next_window_height(active->data(), step), row->get_max().h);
     recalculate_col_geometry(gap_x, gap, true);
 }
 
@@ -552,13 +641,40 @@ void Column::size_active_window(StandardSize height, const Vector2D &gap_x, doub
     recalculate_col_geometry(gap_x, gap, true);
 }
 
+void Column::cycle_size_selection(int step)
+{
+    reorder = Reorder::Auto;
+    for (auto win = windows.first(); win != nullptr; win = win->next()) {
+        if (win->data()->is_selected())
+            win->data()->update_height(next_window_height(win->data(), step), row->get_max().h);
+    }
+}
+
+void Column::size_selection(StandardSize height)
+{
+    reorder = Reorder::Auto;
+    for (auto win = windows.first(); win != nullptr; win = win->next()) {
+        if (win->data()->is_selected())
+            win->data()->update_height(height, row->get_max().h);
+    }
+}
+
+bool Column::has_selection() const
+{
+    for (auto win = windows.first(); win != nullptr; win = win->next()) {
+        if (win->data()->is_selected())
+            return true;
+    }
+    return false;
+}
+
 void Column::resize_active_window(const Vector2D &gap_x, double gap, const Vector2D &delta)
 {
     const Box &max = row->get_max();
     if (!active->data()->can_resize_width(geom.w, max.w, gap_x, gap, delta.x))
         return;
 
-    if (std::abs(static_cast<int>(delta.y)) > 0) {
+    if (!stacked && std::abs(static_cast<int>(delta.y)) > 0) {
         for (auto win = windows.first(); win != nullptr; win = win->next()) {
             auto gap0 = win == windows.first() ? 0.0 : gap;
             auto gap1 = win == windows.last() ? 0.0 : gap;
@@ -577,7 +693,7 @@ void Column::resize_active_window(const Vector2D &gap_x, double gap, const Vecto
             window->set_geom_w(geom.w, gap_x);
         }
     }
-    if (std::abs(static_cast<int>(delta.y)) > 0) {
+    if (!stacked && std::abs(static_cast<int>(delta.y)) > 0) {
         for (auto win = windows.first(); win != nullptr; win = win->next()) {
             Window *window = win->data();
             if (win == active) {
@@ -610,6 +726,8 @@ void Column::adjust_windows(ListNode<Window *> *win, const Vector2D &gap_x, doub
 
 void Column::scroll_update(double delta_y)
 {
+    if (stacked)
+        return;
     for (auto w = windows.first(); w != nullptr; w = w->next()) {
         w->data()->scroll(delta_y);
     }
@@ -617,6 +735,8 @@ void Column::scroll_update(double delta_y)
 
 void Column::scroll_end(Direction dir, double gap)
 {
+    if (stacked)
+        return;
     if (dir == Direction::Up) {
         auto newactive = windows.last();
         // Take the first after active that has its left edge in the viewport
@@ -669,38 +789,33 @@ void Column::selection_all()
     }
 }
 
-void Column::selection_reset()
-{
-    for (auto win = windows.first(); win != nullptr; win = win->next()) {
-        win->data()->selection_reset();
-    }
-}
-
-bool Column::selection_exists() const
-{
-    for (auto win = windows.first(); win != nullptr; win = win->next()) {
-        if (win->data()->is_selected())
-            return true;
-    }
-    return false;
-}
-
 Column *Column::selection_get(const Row *row)
 {
     Column *column = nullptr;
-    List<Window *> selection;
+    List<Window *, LayoutHeap> selection;
     ListNode<Window *> *win = windows.first();
     PHLWORKSPACE workspace = g_pCompositor->getWorkspaceByID(row->get_workspace());
     while (win != nullptr) {
-        auto next = win->next();
-        if (win->data()->is_selected()) {
-            win->data()->move_to_workspace(workspace);
-            selection.push_back(win->data());
-            if (active == win) {
-                active = active != windows.last() ? active->next() : active->prev();
-            }
-            windows.erase(win);
+        if (!win->data()->is_selected()) {
+            win = win->next();
+            continue;
+        }
+        // Take the whole run of consecutive selected windows at once
+        auto last = win;
+        bool has_active = false;
+        for (auto w = win; ; w = w->next()) {
+            w->data()->move_to_workspace(workspace);
+            if (w == active)
+                has_active = true;
+            if (w->next() == nullptr || !w->next()->data()->is_selected())
+                break;
+            last = w->next();
+        }
+        auto next = last->next();
+        if (has_active) {
+            active = next != nullptr ? next : win->prev();
         }
+        windows.extract_range(win, last, selection);
         win = next;
     }
     if (selection.size() > 0) {
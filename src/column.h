@@ -6,12 +6,13 @@
 #include "window.h"
 
 class Row;
+struct RowUsage;
 
-class Column {
+class Column : public AllocCounted<AllocSubsystem::Column> {
 public:
     Column(PHLWINDOW cwindow, const Row *row);
     Column(Window *window, StandardSize width, double maxw, const Row *row);
-    Column(const Row *row, const Column *column, List<Window *> &windows);
+    Column(const Row *row, const Column *column, List<Window *, LayoutHeap> &windows);
     ~Column();
     std::string get_name() const { return name; }
     void set_name (const std::string &str) { name = str; }
@@ -23,8 +24,16 @@ public:
             pWindows.push_back(win->data()->get_window());
         }
     }
+    // Like get_windows(), without the windows hidden behind a stack tab
+    void get_shown_windows(std::vector<PHLWINDOWREF> &pWindows) {
+        for (auto win = windows.first(); win != nullptr; win = win->next()) {
+            if (!win->data()->is_stack_hidden())
+                pWindows.push_back(win->data()->get_window());
+        }
+    }
     bool has_window(PHLWINDOW window) const;
     Window *get_window(PHLWINDOW window) const;
+    void get_usage(RowUsage &usage) const;
     void add_active_window(PHLWINDOW window);
     void remove_window(PHLWINDOW window);
     void focus_window(PHLWINDOW window);
@@ -42,6 +51,11 @@ public:
         geom.w = w;
     }
     Vector2D get_height() const {
+        // Only the active window of a stacked column is shown
+        if (stacked) {
+            double h = active->data()->get_geom_y(0.0);
+            return Vector2D(h, h + active->data()->get_geom_h());
+        }
         double h = windows.first()->data()->get_geom_y(0.0);
         Vector2D height(h, 0.0);
         for (auto win = windows.first(); win != nullptr; win = win->next()) {
@@ -51,6 +65,10 @@ public:
         return height;
     }
     void scale(const Vector2D &bmin, const Vector2D &start, double scale, double gap) {
+        if (stacked) {
+            active->data()->scale(bmin, start, scale, 0.0, 0.0);
+            return;
+        }
         for (auto win = windows.first(); win != nullptr; win = win->next()) {
             auto gap0 = win == windows.first() ? 0.0 : gap;
             auto gap1 = win == windows.last() ? 0.0 : gap;
@@ -90,6 +108,17 @@ public:
     PHLWINDOW get_active_window() {
         return active->data()->get_window();
     }
+    bool active_is_first() const { return active == windows.first(); }
+    bool active_is_last() const { return active == windows.last(); }
+    // Stacked columns show one window at a time, at the full height
+    // of the column, with a tab strip for the rest.
+    bool is_stacked() const { return stacked; }
+    void set_offscreen(bool offscreen) {
+        for (auto w = windows.first(); w != nullptr; w = w->next()) {
+            w->data()->set_offscreen(offscreen);
+        }
+    }
+    void toggle_stacked();
     void move_active_up();
     void move_active_down();
     bool move_focus_up(bool focus_wrap);
@@ -111,20 +140,26 @@ public:
     void fit_size(FitSize fitsize, const Vector2D &gap_x, double gap);
     void cycle_size_active_window(int step, const Vector2D &gap_x, double gap);
     void size_active_window(StandardSize height, const Vector2D &gap_x, double gap);
+    // Change the heights of the selected windows, without recalculating
+    // the geometry of the column.
+    void cycle_size_selection(int step);
+    void size_selection(StandardSize height);
+    bool has_selection() const;
     void resize_active_window(const Vector2D &gap_x, double gap, const Vector2D &delta);
     void selection_toggle();
     void selection_set(PHLWINDOWREF window);
     void selection_all();
-    void selection_reset();
     Column *selection_get(const Row *row);
-    bool selection_exists() const;
     void pin(bool pin) const;
     void scroll_update(double delta_y);
     void scroll_end(Direction dir, double gap);
 
 private:
+    StandardSize next_window_height(Window *window, int step) const;
     // Adjust all the windows in the column using 'window' as anchor
     void adjust_windows(ListNode<Window *> *win, const Vector2D &gap_x, double gap, bool animate);
+    // Lays out the active window of a stacked column, hiding the rest
+    void recalculate_col_geometry_stacked(const Vector2D &gap_x, double y, bool animate);
 
     struct ColumnGeom {
         double x;
@@ -136,10 +171,11 @@ private:
     };
     StandardSize width;
     Reorder reorder;
+    bool stacked;
     ColumnGeom geom; // x location and width of the column
     Memory mem;      // memory
     ListNode<Window *> *active;
-    List<Window *> windows;
+    List<Window *, LayoutHeap> windows;
     std::string name;
     const Row *row;
 };
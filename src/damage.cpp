@@ -0,0 +1,75 @@
+#include <hyprland/src/Compositor.hpp>
+#include <hyprland/src/desktop/Window.hpp>
+#include <hyprland/src/render/Renderer.hpp>
+
+#include "damage.h"
+#include "stats.h"
+
+DamageCollector damage_collector;
+
+// Area of region inside the monitors, which is what gets repainted
+static uint64_t damaged_area(const CRegion &region)
+{
+    uint64_t area = 0;
+    for (auto &monitor : g_pCompositor->m_monitors) {
+        CRegion visible(CBox(monitor->m_position, monitor->m_size));
+        visible.intersect(region);
+        for (auto &rect : visible.getRects()) {
+            area += uint64_t(rect.x2 - rect.x1) * uint64_t(rect.y2 - rect.y1);
+        }
+    }
+    return area;
+}
+
+void DamageCollector::add_window(PHLWINDOW window)
+{
+    if (depth == 0 || window == nullptr)
+        return;
+    region.add(window->getFullWindowBoundingBox());
+    const auto reserved = window->getFullWindowReservedArea();
+    region.add(CBox(window->m_position - reserved.topLeft, window->m_size + reserved.topLeft + reserved.bottomRight));
+}
+
+void DamageCollector::add_box(const CBox &box)
+{
+    if (depth == 0)
+        return;
+    region.add(box);
+}
+
+void DamageCollector::add_monitor(PHLMONITOR monitor)
+{
+    if (depth == 0 || monitor == nullptr)
+        return;
+    for (auto &m : monitors) {
+        if (m == monitor)
+            return;
+    }
+    monitors.push_back(monitor);
+}
+
+void DamageCollector::end()
+{
+    if (depth == 0 || --depth > 0)
+        return;
+
+    for (auto &m : monitors) {
+        auto monitor = m.lock();
+        if (monitor == nullptr)
+            continue;
+        scroller_stats.count(StatsCounter::DamageMonitor);
+        scroller_stats.count(StatsCounter::DamagedArea, uint64_t(monitor->m_size.x * monitor->m_size.y));
+        g_pHyprRenderer->damageMonitor(monitor);
+        // Already fully damaged
+        region.subtract(CBox(monitor->m_position, monitor->m_size));
+    }
+    // damageRegion() only damages the monitors the region intersects
+    if (!region.empty()) {
+        scroller_stats.count(StatsCounter::DamageRegion);
+        scroller_stats.count(StatsCounter::DamagedArea, damaged_area(region));
+        g_pHyprRenderer->damageRegion(region);
+    }
+
+    region.clear();
+    monitors.clear();
+}
@@ -0,0 +1,41 @@
+#ifndef SCROLLER_DAMAGE_H
+#define SCROLLER_DAMAGE_H
+
+#include <hyprland/src/Compositor.hpp>
+
+#include <vector>
+
+// Collects the old and new boxes of the windows the layout moves or resizes
+// while a DamageScope is alive, and damages only their union when the
+// outermost scope ends. Outside a scope, nothing is recorded.
+class DamageCollector {
+public:
+    DamageCollector() : depth(0) {}
+    ~DamageCollector() {}
+
+    void begin() { ++depth; }
+    void end();
+    bool is_collecting() const { return depth > 0; }
+
+    // Call before the window's animated position/size take their new goal:
+    // records the box it is shown in now, and the one it is moving to.
+    void add_window(PHLWINDOW window);
+    void add_box(const CBox &box);
+    // For changes that cannot be expressed as boxes (scaled overview)
+    void add_monitor(PHLMONITOR monitor);
+
+private:
+    int depth;
+    CRegion region;
+    std::vector<PHLMONITORREF> monitors;
+};
+
+extern DamageCollector damage_collector;
+
+class DamageScope {
+public:
+    DamageScope() { damage_collector.begin(); }
+    ~DamageScope() { damage_collector.end(); }
+};
+
+#endif // SCROLLER_DAMAGE_H
@@ -5,13 +5,20 @@
 #include <hyprland/src/plugins/PluginAPI.hpp>
 #include <hyprland/src/render/pass/BorderPassElement.hpp>
 #include <hyprland/src/render/pass/TexPassElement.hpp>
+#include <hyprland/src/render/pass/RectPassElement.hpp>
 
 #include "decorations.h"
 #include "window.h"
+#include "overview.h"
+#include "list.h"
 
 #include <pango/pangocairo.h>
+#include <cmath>
+#include <format>
+#include <unordered_map>
 
 extern HANDLE PHANDLE;
+extern Overview *overviews;
 
 // SelectionBorders
 SelectionBorders::SelectionBorders(Window *window) : IHyprWindowDecoration(window->get_window()), window(window) {
@@ -163,11 +170,86 @@ bool SelectionBorders::doesntWantBorders() {
 }
 
 
+// Jump label textures
+// Rendering text through Pango is slow, and jump destroys all its decorations
+// when it ends, so rendered labels are kept here across jumps. Entries are
+// keyed by label, font, color and size, and the least recently used one is
+// dropped when the cache is full.
+static const size_t LABEL_CACHE_CAPACITY = 256;
+// Sizes are rounded up to multiples of this many pixels, so windows of
+// similar sizes share textures. The texture is scaled to the box anyway.
+static const int LABEL_SIZE_STEP = 16;
+
+struct LabelCacheEntry {
+    SP<CTexture> texture;
+    ListNode<std::string> *lru;
+};
+static List<std::string> label_lru;     // most recently used first
+static std::unordered_map<std::string, LabelCacheEntry> label_textures;
+
+int label_size_bucket(double width)
+{
+    int steps = std::max(1, (int)std::ceil(width / LABEL_SIZE_STEP));
+    return steps * LABEL_SIZE_STEP;
+}
+
+SP<CTexture> jump_label_texture(const std::string &label, int size)
+{
+    static auto  FALLBACKFONT = CConfigValue<std::string>("misc:font_family");
+    static auto const *TEXTFONTFAMILY = (Hyprlang::STRING const *)HyprlandAPI::getConfigValue(PHANDLE, "plugin:scroller:jump_labels_font")->getDataStaticPtr();
+    static auto *const *TEXTCOL = (Hyprlang::INT *const *)HyprlandAPI::getConfigValue(PHANDLE, "plugin:scroller:jump_labels_color")->getDataStaticPtr();
+    std::string font_family(*TEXTFONTFAMILY);
+    if (font_family == "")
+        font_family = *FALLBACKFONT;
+
+    const std::string key = std::format("{}\n{}\n{:x}\n{}", label, font_family, **TEXTCOL, size);
+    auto it = label_textures.find(key);
+    if (it != label_textures.end()) {
+        label_lru.move_before(label_lru.first(), it->second.lru);
+        return it->second.texture;
+    }
+
+    const CHyprColor color = CHyprColor(**TEXTCOL);
+    auto TEXTFONTSIZE = size / label.size();
+    auto texture = g_pHyprOpenGL->renderText(label, color, TEXTFONTSIZE, false, font_family, size);
+
+    if (label_textures.size() >= LABEL_CACHE_CAPACITY) {
+        label_textures.erase(label_lru.last()->data());
+        label_lru.pop_back();
+    }
+    label_lru.push_front(key);
+    label_textures[key] = { texture, label_lru.first() };
+    return texture;
+}
+
+void jump_label_prewarm(PHLWINDOW window, const std::string &label)
+{
+    static auto *const *TEXTSCALE = (Hyprlang::FLOAT *const *)HyprlandAPI::getConfigValue(PHANDLE, "plugin:scroller:jump_labels_scale")->getDataStaticPtr();
+    auto monitor = window->m_monitor.lock();
+    if (monitor == nullptr)
+        return;
+
+    // Same computation as JumpDecoration::draw(), using the final size of
+    // the window, and the scale the overview renders it at.
+    const Vector2D size = window->m_realSize->goal();
+    double scale = monitor->m_scale * (**TEXTSCALE < 0.1 ? 0.1 : **TEXTSCALE > 1.0 ? 1.0 : **TEXTSCALE);
+    if (overviews != nullptr && overviews->overview_enabled(window->workspaceID()))
+        scale *= overviews->data_for(window->workspaceID()).scale;
+    jump_label_texture(label, label_size_bucket(std::round(std::min(size.x, size.y) * scale)));
+}
+
+void jump_labels_cache_clear()
+{
+    label_textures.clear();
+    label_lru.clear();
+}
+
 // JumpDecoration
 JumpDecoration::JumpDecoration(PHLWINDOW window, const std::string &label) : IHyprWindowDecoration(window) {
     m_pWindow = window;
     m_sLabel = label;
     m_iFrames = 0;
+    m_iSize = 0;
     m_pTexture = nullptr;
 }
 
@@ -185,10 +267,9 @@ void JumpDecoration::onPositioningReply(const SDecorationPositioningReply& reply
     m_bAssignedGeometry = reply.assignedGeometry;
 }
 
-CBox JumpDecoration::assignedBoxGlobal() {
+CBox jump_label_box(CBox box)
+{
     static auto *const *TEXTSCALE = (Hyprlang::FLOAT *const *)HyprlandAPI::getConfigValue(PHANDLE, "plugin:scroller:jump_labels_scale")->getDataStaticPtr();
-    CBox box = m_bAssignedGeometry;
-    box.translate(g_pDecorationPositioner->getEdgeDefinedPoint(DECORATION_EDGE_BOTTOM | DECORATION_EDGE_LEFT | DECORATION_EDGE_RIGHT | DECORATION_EDGE_TOP, m_pWindow.lock()));
     if (box.w > box.h) {
         box.x += 0.5 * (box.w - box.h);
         box.w = box.h;
@@ -199,6 +280,13 @@ CBox JumpDecoration::assignedBoxGlobal() {
 
     const double scale = **TEXTSCALE < 0.1 ? 0.1 : **TEXTSCALE > 1.0 ? 1.0 : **TEXTSCALE;
     box.scaleFromCenter(scale);
+    return box;
+}
+
+CBox JumpDecoration::assignedBoxGlobal() {
+    CBox box = m_bAssignedGeometry;
+    box.translate(g_pDecorationPositioner->getEdgeDefinedPoint(DECORATION_EDGE_BOTTOM | DECORATION_EDGE_LEFT | DECORATION_EDGE_RIGHT | DECORATION_EDGE_TOP, m_pWindow.lock()));
+    box = jump_label_box(box);
 
     const auto PWORKSPACE = m_pWindow->m_workspace;
 
@@ -214,20 +302,13 @@ void JumpDecoration::draw(PHLMONITOR pMonitor, float const& a) {
 
     if (windowBox.width < 1 || windowBox.height < 1)
         return;
-    
-    const bool ANIMATED = m_pWindow->m_realPosition->isBeingAnimated() || m_pWindow->m_realSize->isBeingAnimated();
-
-    if (m_pTexture.get() == nullptr) {
-        static auto  FALLBACKFONT = CConfigValue<std::string>("misc:font_family");
-        static auto const *TEXTFONTFAMILY = (Hyprlang::STRING const *)HyprlandAPI::getConfigValue(PHANDLE, "plugin:scroller:jump_labels_font")->getDataStaticPtr();
-        static auto *const *TEXTCOL = (Hyprlang::INT *const *)HyprlandAPI::getConfigValue(PHANDLE, "plugin:scroller:jump_labels_color")->getDataStaticPtr();
-        const CHyprColor color = CHyprColor(**TEXTCOL);
-        std::string font_family(*TEXTFONTFAMILY);
-        if (font_family == "")
-            font_family = *FALLBACKFONT;
-
-        auto TEXTFONTSIZE = windowBox.width / m_sLabel.size();
-        m_pTexture = g_pHyprOpenGL->renderText(m_sLabel, color, TEXTFONTSIZE, false, font_family, windowBox.width);
+
+    // Cheap if the size doesn't change bucket, and the cache makes it cheap
+    // even if it does.
+    const int size = label_size_bucket(windowBox.width);
+    if (m_pTexture.get() == nullptr || size != m_iSize) {
+        m_pTexture = jump_label_texture(m_sLabel, size);
+        m_iSize = size;
     }
 
     CTexPassElement::SRenderData data;
@@ -259,3 +340,132 @@ std::string JumpDecoration::getDisplayName() {
 }
 
 
+// StackTabs
+// One tab per window of a stacked column, drawn on top of its visible window.
+// Titles are only rendered again when they change or the tab width changes.
+StackTabs::StackTabs(PHLWINDOW window) : IHyprWindowDecoration(window) {
+    m_pWindow = window;
+    m_iActive = 0;
+}
+
+StackTabs::~StackTabs() {
+}
+
+SDecorationPositioningInfo StackTabs::getPositioningInfo() {
+    static auto *const *TABSHEIGHT = (Hyprlang::INT *const *)HyprlandAPI::getConfigValue(PHANDLE, "plugin:scroller:stack_tabs_height")->getDataStaticPtr();
+
+    SDecorationPositioningInfo info;
+    info.priority       = 9000;
+    info.policy         = DECORATION_POSITION_STICKY;
+    info.desiredExtents = {{0, (double)**TABSHEIGHT}, {0, 0}};
+    info.reserved       = true;
+    info.edges          = DECORATION_EDGE_TOP;
+    return info;
+}
+
+void StackTabs::onPositioningReply(const SDecorationPositioningReply& reply) {
+    m_bAssignedGeometry = reply.assignedGeometry;
+}
+
+CBox StackTabs::assignedBoxGlobal() {
+    CBox box = m_bAssignedGeometry;
+    box.translate(g_pDecorationPositioner->getEdgeDefinedPoint(DECORATION_EDGE_TOP, m_pWindow.lock()));
+
+    const auto PWORKSPACE = m_pWindow->m_workspace;
+
+    if (!PWORKSPACE)
+        return box;
+
+    const auto WORKSPACEOFFSET = PWORKSPACE && !m_pWindow->m_pinned ? PWORKSPACE->m_renderOffset->value() : Vector2D();
+    return box.translate(WORKSPACEOFFSET);
+}
+
+void StackTabs::set_tabs(const std::vector<PHLWINDOWREF> &windows, size_t active) {
+    bool changed = active != m_iActive || windows.size() != m_vTabs.size();
+    std::vector<Tab> tabs;
+    tabs.reserve(windows.size());
+    for (size_t i = 0; i < windows.size(); ++i) {
+        if (i < m_vTabs.size() && m_vTabs[i].window == windows[i]) {
+            tabs.push_back(m_vTabs[i]);
+        } else {
+            tabs.push_back({ windows[i], "", 0, nullptr });
+            changed = true;
+        }
+    }
+    m_vTabs = std::move(tabs);
+    m_iActive = active;
+    if (changed)
+        damageEntire();
+}
+
+void StackTabs::draw(PHLMONITOR pMonitor, float const& a) {
+    static auto  FALLBACKFONT = CConfigValue<std::string>("misc:font_family");
+    static auto *const *ACTIVECOL = (Hyprlang::INT *const *)HyprlandAPI::getConfigValue(PHANDLE, "plugin:scroller:col.stack_tabs_active")->getDataStaticPtr();
+    static auto *const *INACTIVECOL = (Hyprlang::INT *const *)HyprlandAPI::getConfigValue(PHANDLE, "plugin:scroller:col.stack_tabs_inactive")->getDataStaticPtr();
+    static auto *const *TEXTCOL = (Hyprlang::INT *const *)HyprlandAPI::getConfigValue(PHANDLE, "plugin:scroller:col.stack_tabs_text")->getDataStaticPtr();
+
+    if (m_vTabs.empty())
+        return;
+
+    CBox box = assignedBoxGlobal().translate(-pMonitor->m_position + m_pWindow->m_floatingOffset).scale(pMonitor->m_scale).round();
+    if (box.width < 1 || box.height < 1)
+        return;
+
+    const double tab_w = box.width / m_vTabs.size();
+    for (size_t i = 0; i < m_vTabs.size(); ++i) {
+        Tab &tab = m_vTabs[i];
+        CBox tab_box = { box.x + i * tab_w, box.y, tab_w, box.height };
+        tab_box.round();
+
+        CRectPassElement::SRectData rect;
+        rect.box   = tab_box;
+        rect.color = CHyprColor(i == m_iActive ? **ACTIVECOL : **INACTIVECOL);
+        rect.color.a *= a;
+        g_pHyprRenderer->m_renderPass.add(makeUnique<CRectPassElement>(rect));
+
+        auto window = tab.window.lock();
+        if (window == nullptr)
+            continue;
+        const int width = std::max(1, (int)tab_box.width - 4);
+        if (tab.texture == nullptr || tab.title != window->m_title || tab.width != width) {
+            tab.title = window->m_title;
+            tab.width = width;
+            tab.texture = g_pHyprOpenGL->renderText(tab.title, CHyprColor(**TEXTCOL), std::max(1, (int)(0.6 * box.height / pMonitor->m_scale)),
+                                                    false, *FALLBACKFONT, width);
+        }
+        if (tab.texture == nullptr)
+            continue;
+
+        CTexPassElement::SRenderData data;
+        data.tex = tab.texture;
+        data.box = { tab_box.x + 0.5 * (tab_box.width - tab.texture->m_size.x), tab_box.y + 0.5 * (tab_box.height - tab.texture->m_size.y),
+                     tab.texture->m_size.x, tab.texture->m_size.y };
+        data.a = a;
+        g_pHyprRenderer->m_renderPass.add(makeUnique<CTexPassElement>(data));
+    }
+}
+
+eDecorationType StackTabs::getDecorationType() {
+    return DECORATION_CUSTOM;
+}
+
+void StackTabs::updateWindow(PHLWINDOW) {
+}
+
+void StackTabs::damageEntire() {
+    if (!validMapped(m_pWindow))
+        return;
+    g_pHyprRenderer->damageBox(assignedBoxGlobal());
+}
+
+eDecorationLayer StackTabs::getDecorationLayer() {
+    return DECORATION_LAYER_OVER;
+}
+
+uint64_t StackTabs::getDecorationFlags() {
+    return DECORATION_PART_OF_MAIN_WINDOW;
+}
+
+std::string StackTabs::getDisplayName() {
+    return "StackTabs";
+}
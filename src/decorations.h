@@ -57,7 +57,50 @@ class JumpDecoration : public IHyprWindowDecoration {
 
     std::string m_sLabel;
     int m_iFrames;
+    int m_iSize;
     SP<CTexture> m_pTexture;
 };
 
+class StackTabs : public IHyprWindowDecoration {
+  public:
+    StackTabs(PHLWINDOW);
+    virtual ~StackTabs();
+
+    virtual SDecorationPositioningInfo getPositioningInfo();
+    virtual void                       onPositioningReply(const SDecorationPositioningReply& reply);
+    virtual void                       draw(PHLMONITOR, float const& a);
+    virtual eDecorationType            getDecorationType();
+    virtual void                       updateWindow(PHLWINDOW);
+    virtual void                       damageEntire();
+    virtual eDecorationLayer           getDecorationLayer();
+    virtual uint64_t                   getDecorationFlags();
+    virtual std::string                getDisplayName();
+
+    // Windows of the stacked column, in order, and the index of the active one
+    void set_tabs(const std::vector<PHLWINDOWREF> &windows, size_t active);
+
+  private:
+    struct Tab {
+        PHLWINDOWREF window;
+        std::string title;
+        int width;
+        SP<CTexture> texture;
+    };
+
+    PHLWINDOWREF m_pWindow;
+    CBox m_bAssignedGeometry = { 0 };
+    CBox assignedBoxGlobal();
+
+    std::vector<Tab> m_vTabs;
+    size_t m_iActive;
+};
+
+// Jump label textures are cached across jumps
+int label_size_bucket(double width);
+// The label of a window box: a square at its center, scaled by jump_labels_scale
+CBox jump_label_box(CBox box);
+SP<CTexture> jump_label_texture(const std::string &label, int size);
+void jump_label_prewarm(PHLWINDOW window, const std::string &label);
+void jump_labels_cache_clear();
+
 #endif  // SCROLLER_DECORATIONS_H
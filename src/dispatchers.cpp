@@ -9,6 +9,9 @@
 #include "enums.h"
 #include "dispatchers.h"
 #include "scroller.h"
+#include "stats.h"
+#include "trace.h"
+#include "recorder.h"
 
 
 extern HANDLE PHANDLE;
@@ -72,9 +75,10 @@ namespace dispatchers {
         if (workspace == -1)
             return { .success = false, .error = "scroller:cyclesize: invalid workspace" };
 
-        int step = parse_step_arg(arg);
+        auto args = CVarList(arg);
+        int step = parse_step_arg(args[0]);
         if (step != 0)
-            g_ScrollerLayout->cycle_window_size(workspace, step);
+            g_ScrollerLayout->cycle_window_size(workspace, step, args[1] == "selection");
 
         return {};
     }
@@ -84,9 +88,10 @@ namespace dispatchers {
         if (workspace == -1)
             return { .success = false, .error = "scroller:cyclewidth: invalid workspace" };
 
-        int step = parse_step_arg(arg);
+        auto args = CVarList(arg);
+        int step = parse_step_arg(args[0]);
         if (step != 0)
-            g_ScrollerLayout->cycle_window_width(workspace, step);
+            g_ScrollerLayout->cycle_window_width(workspace, step, args[1] == "selection");
 
         return {};
     }
@@ -96,9 +101,10 @@ namespace dispatchers {
         if (workspace == -1)
             return { .success = false, .error = "scroller:cycleheight: invalid workspace" };
 
-        int step = parse_step_arg(arg);
+        auto args = CVarList(arg);
+        int step = parse_step_arg(args[0]);
         if (step != 0)
-            g_ScrollerLayout->cycle_window_height(workspace, step);
+            g_ScrollerLayout->cycle_window_height(workspace, step, args[1] == "selection");
 
         return {};
     }
@@ -108,7 +114,8 @@ namespace dispatchers {
         if (workspace == -1)
             return { .success = false, .error = "scroller:setsize: invalid workspace" };
 
-        g_ScrollerLayout->set_window_size(workspace, arg);
+        auto args = CVarList(arg);
+        g_ScrollerLayout->set_window_size(workspace, args[0], args[1] == "selection");
 
         return {};
     }
@@ -118,7 +125,8 @@ namespace dispatchers {
         if (workspace == -1)
             return { .success = false, .error = "scroller:setwidth: invalid workspace" };
 
-        g_ScrollerLayout->set_window_width(workspace, arg);
+        auto args = CVarList(arg);
+        g_ScrollerLayout->set_window_width(workspace, args[0], args[1] == "selection");
 
         return {};
     }
@@ -128,7 +136,8 @@ namespace dispatchers {
         if (workspace == -1)
             return { .success = false, .error = "scroller:setheight: invalid workspace" };
 
-        g_ScrollerLayout->set_window_height(workspace, arg);
+        auto args = CVarList(arg);
+        g_ScrollerLayout->set_window_height(workspace, args[0], args[1] == "selection");
 
         return {};
     }
@@ -250,6 +259,8 @@ namespace dispatchers {
             return FitSize::ToEnd;
         else if (arg == "tobeg" || arg == "tobeginning")
             return FitSize::ToBeg;
+        else if (arg == "selection")
+            return FitSize::Selection;
         else
             return {};
     }
@@ -298,6 +309,15 @@ namespace dispatchers {
 
         return {};
     }
+    SDispatchResult dispatch_togglestack(std::string) {
+        auto workspace = workspace_for_action();
+        if (workspace == -1)
+            return { .success = false, .error = "scroller:togglestack: invalid workspace" };
+
+        g_ScrollerLayout->toggle_stack(workspace);
+
+        return {};
+    }
     SDispatchResult dispatch_marksadd(std::string arg) {
         auto workspace = workspace_for_action();
         if (workspace == -1)
@@ -451,50 +471,104 @@ namespace dispatchers {
 
         return {};
     }
-    SDispatchResult dispatch_jump(std::string) {
+    SDispatchResult dispatch_jump(std::string arg) {
         if (g_pLayoutManager->getCurrentLayout() != g_ScrollerLayout.get())
             return { .success = false, .error = "scroller:jump: called while not running hyprscroller" };
 
-        g_ScrollerLayout->jump();
+        auto args = CVarList(arg);
+        g_ScrollerLayout->jump(args[0] == "visible");
 
         return {};
     }
+    // params: start [events] | stop | dump path
+    SDispatchResult dispatch_trace(std::string arg) {
+        auto args = CVarList(arg);
+        if (args[0] == "start") {
+            size_t capacity = 65536;
+            if (args[1] != "") {
+                try {
+                    capacity = std::stoul(args[1]);
+                } catch (...) {
+                    return { .success = false, .error = "scroller:trace: invalid number of events" };
+                }
+            }
+            scroller_trace.start(capacity);
+        } else if (args[0] == "stop") {
+            scroller_trace.stop();
+        } else if (args[0] == "dump") {
+            if (args[1] == "")
+                return { .success = false, .error = "scroller:trace: missing file name" };
+            if (!scroller_trace.dump(args[1]))
+                return { .success = false, .error = "scroller:trace: cannot write " + args[1] };
+        } else {
+            return { .success = false, .error = "scroller:trace: use start, stop or dump" };
+        }
+        return {};
+    }
+    // params: start, file | stop
+    SDispatchResult dispatch_record(std::string arg) {
+        auto args = CVarList(arg);
+        if (args[0] == "start") {
+            if (args[1] == "")
+                return { .success = false, .error = "scroller:record: missing file name" };
+            if (!scroller_recorder.start(args[1]))
+                return { .success = false, .error = "scroller:record: cannot write " + args[1] };
+        } else if (args[0] == "stop") {
+            scroller_recorder.stop();
+        } else {
+            return { .success = false, .error = "scroller:record: use start or stop" };
+        }
+        return {};
+    }
+    // Registers a dispatcher, timing every call in scroller_stats
+    void add_dispatcher(const std::string &name, SDispatchResult (*dispatcher)(std::string)) {
+        StatsOperation *stats = scroller_stats.get(name);
+        HyprlandAPI::addDispatcherV2(PHANDLE, name, [stats, dispatcher](std::string arg) {
+            StatsScope scope(stats);
+            scroller_recorder.record(ScrollerRecorder::Event::Dispatch, 0, {}, { stats->name, arg });
+            return dispatcher(arg);
+        });
+    }
+
     void addDispatchers() {
-        HyprlandAPI::addDispatcherV2(PHANDLE, "scroller:cyclesize", dispatch_cyclesize);
-        HyprlandAPI::addDispatcherV2(PHANDLE, "scroller:cyclewidth", dispatch_cyclewidth);
-        HyprlandAPI::addDispatcherV2(PHANDLE, "scroller:cycleheight", dispatch_cycleheight);
-        HyprlandAPI::addDispatcherV2(PHANDLE, "scroller:setsize", dispatch_setsize);
-        HyprlandAPI::addDispatcherV2(PHANDLE, "scroller:setwidth", dispatch_setwidth);
-        HyprlandAPI::addDispatcherV2(PHANDLE, "scroller:setheight", dispatch_setheight);
-        HyprlandAPI::addDispatcherV2(PHANDLE, "scroller:movefocus", dispatch_movefocus);
-        HyprlandAPI::addDispatcherV2(PHANDLE, "scroller:movewindow", dispatch_movewindow);
-        HyprlandAPI::addDispatcherV2(PHANDLE, "scroller:alignwindow", dispatch_alignwindow);
-        HyprlandAPI::addDispatcherV2(PHANDLE, "scroller:admitwindow", dispatch_admitwindow);
-        HyprlandAPI::addDispatcherV2(PHANDLE, "scroller:expelwindow", dispatch_expelwindow);
-        HyprlandAPI::addDispatcherV2(PHANDLE, "scroller:setmode", dispatch_setmode);
-        HyprlandAPI::addDispatcherV2(PHANDLE, "scroller:setmodemodifier", dispatch_setmodemodifier);
-        HyprlandAPI::addDispatcherV2(PHANDLE, "scroller:fitsize", dispatch_fitsize);
-        HyprlandAPI::addDispatcherV2(PHANDLE, "scroller:fitwidth", dispatch_fitwidth);
-        HyprlandAPI::addDispatcherV2(PHANDLE, "scroller:fitheight", dispatch_fitheight);
-        HyprlandAPI::addDispatcherV2(PHANDLE, "scroller:toggleoverview", dispatch_toggleoverview);
-        HyprlandAPI::addDispatcherV2(PHANDLE, "scroller:marksadd", dispatch_marksadd);
-        HyprlandAPI::addDispatcherV2(PHANDLE, "scroller:marksdelete", dispatch_marksdelete);
-        HyprlandAPI::addDispatcherV2(PHANDLE, "scroller:marksvisit", dispatch_marksvisit);
-        HyprlandAPI::addDispatcherV2(PHANDLE, "scroller:marksreset", dispatch_marksreset);
-        HyprlandAPI::addDispatcherV2(PHANDLE, "scroller:pin", dispatch_pin);
-        HyprlandAPI::addDispatcherV2(PHANDLE, "scroller:selectiontoggle", dispatch_selectiontoggle);
-        HyprlandAPI::addDispatcherV2(PHANDLE, "scroller:selectionreset", dispatch_selectionreset);
-        HyprlandAPI::addDispatcherV2(PHANDLE, "scroller:selectionworkspace", dispatch_selectionworkspace);
-        HyprlandAPI::addDispatcherV2(PHANDLE, "scroller:selectionmove", dispatch_selectionmove);
-        HyprlandAPI::addDispatcherV2(PHANDLE, "scroller:trailnew", dispatch_trailnew);
-        HyprlandAPI::addDispatcherV2(PHANDLE, "scroller:trailnext", dispatch_trailnext);
-        HyprlandAPI::addDispatcherV2(PHANDLE, "scroller:trailprevious", dispatch_trailprev);
-        HyprlandAPI::addDispatcherV2(PHANDLE, "scroller:traildelete", dispatch_traildelete);
-        HyprlandAPI::addDispatcherV2(PHANDLE, "scroller:trailclear", dispatch_trailclear);
-        HyprlandAPI::addDispatcherV2(PHANDLE, "scroller:trailtoselection", dispatch_trailtoselection);
-        HyprlandAPI::addDispatcherV2(PHANDLE, "scroller:trailmarktoggle", dispatch_trailmarktoggle);
-        HyprlandAPI::addDispatcherV2(PHANDLE, "scroller:trailmarknext", dispatch_trailmarknext);
-        HyprlandAPI::addDispatcherV2(PHANDLE, "scroller:trailmarkprevious", dispatch_trailmarkprev);
-        HyprlandAPI::addDispatcherV2(PHANDLE, "scroller:jump", dispatch_jump);
+        add_dispatcher("scroller:cyclesize", dispatch_cyclesize);
+        add_dispatcher("scroller:cyclewidth", dispatch_cyclewidth);
+        add_dispatcher("scroller:cycleheight", dispatch_cycleheight);
+        add_dispatcher("scroller:setsize", dispatch_setsize);
+        add_dispatcher("scroller:setwidth", dispatch_setwidth);
+        add_dispatcher("scroller:setheight", dispatch_setheight);
+        add_dispatcher("scroller:movefocus", dispatch_movefocus);
+        add_dispatcher("scroller:movewindow", dispatch_movewindow);
+        add_dispatcher("scroller:alignwindow", dispatch_alignwindow);
+        add_dispatcher("scroller:admitwindow", dispatch_admitwindow);
+        add_dispatcher("scroller:expelwindow", dispatch_expelwindow);
+        add_dispatcher("scroller:setmode", dispatch_setmode);
+        add_dispatcher("scroller:setmodemodifier", dispatch_setmodemodifier);
+        add_dispatcher("scroller:fitsize", dispatch_fitsize);
+        add_dispatcher("scroller:fitwidth", dispatch_fitwidth);
+        add_dispatcher("scroller:fitheight", dispatch_fitheight);
+        add_dispatcher("scroller:toggleoverview", dispatch_toggleoverview);
+        add_dispatcher("scroller:togglestack", dispatch_togglestack);
+        add_dispatcher("scroller:marksadd", dispatch_marksadd);
+        add_dispatcher("scroller:marksdelete", dispatch_marksdelete);
+        add_dispatcher("scroller:marksvisit", dispatch_marksvisit);
+        add_dispatcher("scroller:marksreset", dispatch_marksreset);
+        add_dispatcher("scroller:pin", dispatch_pin);
+        add_dispatcher("scroller:selectiontoggle", dispatch_selectiontoggle);
+        add_dispatcher("scroller:selectionreset", dispatch_selectionreset);
+        add_dispatcher("scroller:selectionworkspace", dispatch_selectionworkspace);
+        add_dispatcher("scroller:selectionmove", dispatch_selectionmove);
+        add_dispatcher("scroller:trailnew", dispatch_trailnew);
+        add_dispatcher("scroller:trailnext", dispatch_trailnext);
+        add_dispatcher("scroller:trailprevious", dispatch_trailprev);
+        add_dispatcher("scroller:traildelete", dispatch_traildelete);
+        add_dispatcher("scroller:trailclear", dispatch_trailclear);
+        add_dispatcher("scroller:trailtoselection", dispatch_trailtoselection);
+        add_dispatcher("scroller:trailmarktoggle", dispatch_trailmarktoggle);
+        add_dispatcher("scroller:trailmarknext", dispatch_trailmarknext);
+        add_dispatcher("scroller:trailmarkprevious", dispatch_trailmarkprev);
+        add_dispatcher("scroller:jump", dispatch_jump);
+        add_dispatcher("scroller:trace", dispatch_trace);
+        add_dispatcher("scroller:record", dispatch_record);
     }
 }
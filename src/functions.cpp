@@ -1,9 +1,12 @@
 #include "functions.h"
 #include "dispatchers.h"
+#include "stats.h"
+#include "allocs.h"
 
 #include <hyprland/src/Compositor.hpp>
 #include <hyprland/src/helpers/Monitor.hpp>
 #include <hyprland/src/managers/input/InputManager.hpp>
+#include <hyprland/src/managers/EventManager.hpp>
 
 SDispatchResult this_moveFocusTo(std::string args)
 {
@@ -58,6 +61,7 @@ void update_relative_cursor_coords(PHLWINDOW window)
 void force_focus_to_window(PHLWINDOW window)
 {
     g_pInputManager->unconstrainMouse();
+    scroller_stats.count(StatsCounter::FocusWindow);
     g_pCompositor->focusWindow(window);
     window->warpCursor();
 
@@ -102,3 +106,10 @@ void switch_to_window(PHLWINDOW from, PHLWINDOW to)
     return;
 }
 
+
+// Posts a "scroller" IPC event
+void post_scroller_event(const std::string &data)
+{
+    scroller_allocs.add_string(AllocSubsystem::Events, data);
+    g_pEventManager->postEvent(SHyprIPCEvent{"scroller", data});
+}
@@ -13,5 +13,6 @@ WORKSPACEID get_workspace_id();
 void update_relative_cursor_coords(PHLWINDOW window);
 void force_focus_to_window(PHLWINDOW window);
 void switch_to_window(PHLWINDOW from, PHLWINDOW to);
+void post_scroller_event(const std::string &data);
 
 #endif // SCROLLER_FUNCTIONS_H
@@ -0,0 +1,53 @@
+#include <hyprland/src/SharedDefs.hpp>
+#include <hyprland/src/plugins/PluginAPI.hpp>
+#include <hyprutils/string/VarList.hpp>
+
+#include "hyprctl.h"
+#include "scroller.h"
+#include "stats.h"
+#include "allocs.h"
+
+extern HANDLE PHANDLE;
+extern std::unique_ptr<ScrollerLayout> g_ScrollerLayout;
+
+namespace hyprctl {
+    // hyprctl passes the whole request, "scroller <command> [args...]"
+    std::string request(eHyprCtlOutputFormat format, std::string request) {
+        auto args = CVarList(request, 0, ' ');
+        const bool json = format == eHyprCtlOutputFormat::FORMAT_JSON;
+
+        if (args[1] == "stats") {
+            if (args[2] == "reset") {
+                scroller_stats.reset();
+                return "ok";
+            }
+            return scroller_stats.report(json);
+        } else if (args[1] == "counters") {
+            if (args[2] == "reset") {
+                scroller_stats.reset_counters();
+                return "ok";
+            } else if (args[2] == "check") {
+                return scroller_stats.check_counters();
+            }
+            return scroller_stats.report_counters(json);
+        } else if (args[1] == "allocs") {
+            if (args[2] == "on" || args[2] == "off") {
+                scroller_allocs.set_enabled(args[2] == "on");
+                return "ok";
+            } else if (args[2] == "reset") {
+                scroller_allocs.reset();
+                return "ok";
+            } else if (args[2] == "check") {
+                return scroller_allocs.check();
+            }
+            return scroller_allocs.report(json);
+        } else if (args[1] == "memory") {
+            return g_ScrollerLayout->memory_report(json);
+        }
+        return "scroller: unknown request, use one of: stats [reset], counters [reset|check], allocs [on|off|reset|check], memory";
+    }
+
+    void addCommands() {
+        HyprlandAPI::registerHyprCtlCommand(PHANDLE, SHyprCtlCommand { .name = "scroller", .exact = false, .fn = request });
+    }
+}
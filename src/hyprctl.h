@@ -0,0 +1,9 @@
+#ifndef SCROLLER_HYPRCTL_H
+#define SCROLLER_HYPRCTL_H
+
+namespace hyprctl {
+    // Registers the `hyprctl scroller ...` requests
+    void addCommands();
+}
+
+#endif // SCROLLER_HYPRCTL_H
@@ -2,8 +2,15 @@
 #define SCROLLER_LIST_H
 
 #include <algorithm>
+#include <cstddef>
 
-template<typename T> class List;
+// Default Heap of List: node allocations are not reported anywhere
+struct ListHeap {
+    static void allocated(size_t) {}
+    static void freed(size_t) {}
+};
+
+template<typename T, typename Heap> class List;
 
 template<typename T>
 class ListNode {
@@ -18,13 +25,14 @@ public:
     ListNode *prev() const { return m_prev; }
 
 private:
-    friend class List<T>;
+    template<typename, typename> friend class List;
     ListNode *m_prev;
     ListNode *m_next;
     T m_data;
 };
 
-template<typename T>
+// Heap is told about every node the list allocates or frees
+template<typename T, typename Heap = ListHeap>
 class List {
 public:
     List() : m_size(0), m_first(nullptr), m_last(nullptr) {}
@@ -35,7 +43,7 @@ public:
         auto node = m_last;
         while (node) {
             auto prev = node->prev();
-            delete node;
+            free_node(node);
             node = prev;
         }
         m_size = 0;
@@ -72,7 +80,7 @@ public:
     }
 
     ListNode<T> *emplace_after(ListNode<T> *it, T value) {
-        auto next = new ListNode<T>(value);
+        auto next = new_node(value);
         if (it == m_last) {
             m_last = next;
             // check here to see if size is stil zero
@@ -92,7 +100,7 @@ public:
     }
 
     ListNode<T> *emplace_before(ListNode<T> *it, T value) {
-        auto prev = new ListNode<T>(value);
+        auto prev = new_node(value);
         if (it == m_first) {
             m_first = prev;
             // check here to see if size is stil zero
@@ -122,7 +130,7 @@ public:
         } else {
             m_last = it->m_prev;
         }
-        delete it;
+        free_node(it);
         m_size--;
     }
 
@@ -178,7 +186,95 @@ public:
         dst->m_next = src;
     }
 
+    // Unlinks the nodes in [first, last] and appends them to dst, without
+    // any allocation. Linear only in the length of the range (to keep sizes).
+    void extract_range(ListNode<T> *first, ListNode<T> *last, List &dst) {
+        if (first == nullptr || last == nullptr)
+            return;
+        size_t count = 1;
+        for (auto node = first; node != last; node = node->m_next) {
+            ++count;
+        }
+        unlink(first, last);
+        m_size -= count;
+        first->m_prev = dst.m_last;
+        last->m_next = nullptr;
+        if (dst.m_last != nullptr)
+            dst.m_last->m_next = first;
+        else
+            dst.m_first = first;
+        dst.m_last = last;
+        dst.m_size += count;
+    }
+
+    // Moves all the nodes of other before it (at the end if it is nullptr),
+    // leaving other empty. Constant time, no allocations.
+    void splice_before(ListNode<T> *it, List &other) {
+        if (&other == this || other.empty())
+            return;
+        if (it == nullptr) {
+            link(m_last, other.m_first, other.m_last, nullptr);
+        } else {
+            link(it->m_prev, other.m_first, other.m_last, it);
+        }
+        m_size += other.m_size;
+        other.m_first = other.m_last = nullptr;
+        other.m_size = 0;
+    }
+
+    // Moves all the nodes of other after it (at the beginning if it is nullptr),
+    // leaving other empty. Constant time, no allocations.
+    void splice_after(ListNode<T> *it, List &other) {
+        if (&other == this || other.empty())
+            return;
+        if (it == nullptr) {
+            link(nullptr, other.m_first, other.m_last, m_first);
+        } else {
+            link(it, other.m_first, other.m_last, it->m_next);
+        }
+        m_size += other.m_size;
+        other.m_first = other.m_last = nullptr;
+        other.m_size = 0;
+    }
+
 private:
+    static ListNode<T> *new_node(T value) {
+        Heap::allocated(sizeof(ListNode<T>));
+        return new ListNode<T>(value);
+    }
+    static void free_node(ListNode<T> *node) {
+        Heap::freed(sizeof(ListNode<T>));
+        delete node;
+    }
+
+    // Removes [first, last] from the chain, without touching their links or size
+    void unlink(ListNode<T> *first, ListNode<T> *last) {
+        if (first->m_prev != nullptr) {
+            first->m_prev->m_next = last->m_next;
+        } else {
+            m_first = last->m_next;
+        }
+        if (last->m_next != nullptr) {
+            last->m_next->m_prev = first->m_prev;
+        } else {
+            m_last = first->m_prev;
+        }
+    }
+
+    // Links the chain [first, last] between prev and next
+    void link(ListNode<T> *prev, ListNode<T> *first, ListNode<T> *last, ListNode<T> *next) {
+        first->m_prev = prev;
+        last->m_next = next;
+        if (prev != nullptr)
+            prev->m_next = first;
+        else
+            m_first = first;
+        if (next != nullptr)
+            next->m_prev = last;
+        else
+            m_last = last;
+    }
+
     size_t m_size;
     ListNode<T> *m_first;
     ListNode<T> *m_last;
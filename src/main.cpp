@@ -4,6 +4,7 @@
 #include <hyprlang.hpp>
 
 #include "dispatchers.h"
+#include "hyprctl.h"
 #include "scroller.h"
 
 HANDLE PHANDLE = nullptr;
@@ -28,6 +29,7 @@ APICALL EXPORT PLUGIN_DESCRIPTION_INFO PLUGIN_INIT(HANDLE handle) {
     HyprlandAPI::addLayout(PHANDLE, "scroller", g_ScrollerLayout.get());
 
     dispatchers::addDispatchers();
+    hyprctl::addCommands();
 
     // one value out of: { onesixth, onefourth, onethird, onehalf (default), twothirds, floating, maximized }
     HyprlandAPI::addConfigValue(PHANDLE, "plugin:scroller:column_default_width", Hyprlang::STRING{"onehalf"});
@@ -49,10 +51,16 @@ APICALL EXPORT PLUGIN_DESCRIPTION_INFO PLUGIN_INIT(HANDLE handle) {
     HyprlandAPI::addConfigValue(PHANDLE, "plugin:scroller:center_active_window", Hyprlang::INT{0});
     // 0, 1
     HyprlandAPI::addConfigValue(PHANDLE, "plugin:scroller:center_active_column", Hyprlang::INT{0});
+    // -1 (disabled), distance in pixels from the viewport
+    HyprlandAPI::addConfigValue(PHANDLE, "plugin:scroller:offscreen_suspend_distance", Hyprlang::INT{-1});
     // 0, 1
     HyprlandAPI::addConfigValue(PHANDLE, "plugin:scroller:overview_scale_content", Hyprlang::INT{1});
     // 0, 1
     HyprlandAPI::addConfigValue(PHANDLE, "plugin:scroller:overview_render_layers", Hyprlang::INT{1});
+    // 0, 1
+    HyprlandAPI::addConfigValue(PHANDLE, "plugin:scroller:overview_persistent_hooks", Hyprlang::INT{0});
+    // 0, 1
+    HyprlandAPI::addConfigValue(PHANDLE, "plugin:scroller:overview_warmup", Hyprlang::INT{0});
     // a list of values used as standard widths for cyclesize in row mode, and in the cycling order
     // available options: oneeighth, onesixth, onefourth, onethird, threeeighths, onehalf,
     // fiveeighths, twothirds, threequarters, fivesixths, seveneighths, one
@@ -78,6 +86,7 @@ APICALL EXPORT PLUGIN_DESCRIPTION_INFO PLUGIN_INIT(HANDLE handle) {
     HyprlandAPI::addConfigValue(PHANDLE, "plugin:scroller:gesture_overview_fingers", Hyprlang::INT{4});
     HyprlandAPI::addConfigValue(PHANDLE, "plugin:scroller:gesture_scroll_enable", Hyprlang::INT{1});
     HyprlandAPI::addConfigValue(PHANDLE, "plugin:scroller:gesture_scroll_fingers", Hyprlang::INT{3});
+    HyprlandAPI::addConfigValue(PHANDLE, "plugin:scroller:gesture_scroll_render_offset", Hyprlang::INT{0});
     HyprlandAPI::addConfigValue(PHANDLE, "plugin:scroller:gesture_workspace_switch_enable", Hyprlang::INT{1});
     HyprlandAPI::addConfigValue(PHANDLE, "plugin:scroller:gesture_workspace_switch_distance", Hyprlang::INT{5});
     HyprlandAPI::addConfigValue(PHANDLE, "plugin:scroller:gesture_workspace_switch_fingers", Hyprlang::INT{4});
@@ -85,6 +94,11 @@ APICALL EXPORT PLUGIN_DESCRIPTION_INFO PLUGIN_INIT(HANDLE handle) {
 
     HyprlandAPI::addConfigValue(PHANDLE, "plugin:scroller:col.selection_border", Hyprlang::INT{0xff9e1515});
 
+    HyprlandAPI::addConfigValue(PHANDLE, "plugin:scroller:stack_tabs_height", Hyprlang::INT{20});
+    HyprlandAPI::addConfigValue(PHANDLE, "plugin:scroller:col.stack_tabs_active", Hyprlang::INT{0xff9e1515});
+    HyprlandAPI::addConfigValue(PHANDLE, "plugin:scroller:col.stack_tabs_inactive", Hyprlang::INT{0xff303030});
+    HyprlandAPI::addConfigValue(PHANDLE, "plugin:scroller:col.stack_tabs_text", Hyprlang::INT{0xffffffff});
+
     HyprlandAPI::addConfigValue(PHANDLE, "plugin:scroller:jump_labels_font", Hyprlang::STRING{""});
     HyprlandAPI::addConfigValue(PHANDLE, "plugin:scroller:jump_labels_scale", Hyprlang::FLOAT{0.5});
     HyprlandAPI::addConfigValue(PHANDLE, "plugin:scroller:jump_labels_color", Hyprlang::INT{0x80159e30});
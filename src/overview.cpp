@@ -4,6 +4,12 @@
 #include <hyprland/src/render/Renderer.hpp>
 
 #include "overview.h"
+#include "trace.h"
+#include "stats.h"
+
+#include <atomic>
+#include <string>
+#include <unordered_map>
 
 extern HANDLE PHANDLE;
 
@@ -18,6 +24,11 @@ inline CFunctionHook* g_pGetCursorPosForMonitorHook = nullptr;
 
 Overview *overviews = nullptr;
 
+// True while any workspace is in overview mode. When the hooks stay installed
+// (overview_persistent_hooks), they check it first and go straight to the
+// original function when there is nothing to do.
+static std::atomic<bool> overview_active(false);
+
 typedef bool (*origVisibleOnMonitor)(void *thisptr, PHLMONITOR monitor);
 typedef void (*origRenderLayer)(void *thisptr, PHLLS pLayer, PHLMONITOR pMonitor, const Time::steady_tp&, bool popups, bool lockscreen);
 typedef CBox (*origLogicalBox)(CMonitor *thisptr);
@@ -54,6 +65,8 @@ private:
 
 // Needed to show windows that are outside of the viewport
 static bool hookVisibleOnMonitor(void *thisptr, PHLMONITOR monitor) {
+    if (!overview_active.load(std::memory_order_relaxed))
+        return ((origVisibleOnMonitor)(g_pVisibleOnMonitorHook->m_original))(thisptr, monitor);
     CWindow *window = static_cast<CWindow *>(thisptr);
     if (overviews->overview_enabled(window->workspaceID())) {
         return true;
@@ -63,6 +76,11 @@ static bool hookVisibleOnMonitor(void *thisptr, PHLMONITOR monitor) {
 
 // Needed to undo the monitor scale to render layers at the original scale
 static void hookRenderLayer(void *thisptr, PHLLS layer, PHLMONITOR monitor, const Time::steady_tp& time, bool popups, bool lockscreen) {
+    if (!overview_active.load(std::memory_order_relaxed)) {
+        ((origRenderLayer)(g_pRenderLayerHook->m_original))(thisptr, layer, monitor, time, popups, lockscreen);
+        return;
+    }
+    TraceScope trace("Overview::hookRenderLayer");
     static auto* const *ENABLE_RENDER = (Hyprlang::INT* const *)HyprlandAPI::getConfigValue(PHANDLE, "plugin:scroller:overview_render_layers")->getDataStaticPtr();
     if (!**ENABLE_RENDER)
         return;
@@ -77,6 +95,7 @@ static void hookRenderLayer(void *thisptr, PHLLS layer, PHLMONITOR monitor, cons
         modif_data.modifs.push_back({SRenderModifData::eRenderModifType::RMOD_TYPE_SCALE, data.scale_i});
         modif_data.enabled = true;
         g_pHyprRenderer->m_renderPass.add(makeUnique<OverviewPassElement>(OverviewPassElement::OverviewModifData(modif_data)));
+        scroller_stats.count(StatsCounter::DamageMonitor);
         g_pHyprRenderer->damageMonitor(monitor);
         ((origRenderLayer)(g_pRenderLayerHook->m_original))(thisptr, layer, monitor, time, popups, lockscreen);
         g_pHyprRenderer->m_renderPass.add(makeUnique<OverviewPassElement>(OverviewPassElement::OverviewModifData(SRenderModifData())));
@@ -88,6 +107,8 @@ static void hookRenderLayer(void *thisptr, PHLLS layer, PHLMONITOR monitor, cons
 
 // Needed to scale the range of the cursor in overview mode to cover the whole area.
 static CBox hookLogicalBox(CMonitor *thisptr) {
+    if (!overview_active.load(std::memory_order_relaxed))
+        return ((origLogicalBox)(g_pLogicalBoxHook->m_original))(thisptr);
     WORKSPACEID workspace = thisptr->activeSpecialWorkspaceID();
     if (!workspace)
         workspace = thisptr->activeWorkspaceID();
@@ -101,6 +122,11 @@ static CBox hookLogicalBox(CMonitor *thisptr) {
 static void hookRenderSoftwareCursorsFor(void *thisptr, PHLMONITOR monitor, const Time::steady_tp& now, CRegion& damage, std::optional<Vector2D> overridePos, bool forceRender) {
     // Should render the cursor for all the extent of the workspace, and only on
     // overview workspaces when there is one active, and it is in the current monitor.
+    if (!overview_active.load(std::memory_order_relaxed)) {
+        ((origRenderSoftwareCursorsFor)(g_pRenderSoftwareCursorsForHook->m_original))(thisptr, monitor, now, damage, overridePos, forceRender);
+        return;
+    }
+    TraceScope trace("Overview::hookRenderSoftwareCursorsFor");
     PHLMONITOR last = g_pCompositor->m_lastMonitor.lock();
 
     if (monitor == last) {
@@ -119,6 +145,8 @@ static void hookRenderSoftwareCursorsFor(void *thisptr, PHLMONITOR monitor, cons
 // Needed to fake an overview monitor's desktop contains all its windows
 // instead of some of them being in the other monitor.
 static Vector2D hookClosestValid(void *thisptr, const Vector2D& pos) {
+    if (!overview_active.load(std::memory_order_relaxed))
+        return ((origClosestValid)(g_pClosestValidHook->m_original))(thisptr, pos);
     PHLMONITOR last = g_pCompositor->m_lastMonitor.lock();
     WORKSPACEID workspace = last->activeSpecialWorkspaceID();
     if (!workspace)
@@ -138,6 +166,8 @@ static Vector2D hookClosestValid(void *thisptr, const Vector2D& pos) {
 
 // Needed to select the correct monitor for a cursor when two can contain it.
 static PHLMONITOR hookGetMonitorFromVector(void *thisptr, const Vector2D& point) {
+    if (!overview_active.load(std::memory_order_relaxed))
+        return ((origGetMonitorFromVector)(g_pGetMonitorFromVectorHook->m_original))(thisptr, point);
     CCompositor *compositor = static_cast<CCompositor *>(thisptr);
     // First, see if the current monitor contains the point
     PHLMONITOR last = compositor->m_lastMonitor.lock();
@@ -186,6 +216,11 @@ static PHLMONITOR hookGetMonitorFromVector(void *thisptr, const Vector2D& point)
 }
 
 static void hookRenderMonitor(CHyprRenderer *thisptr, PHLMONITOR monitor, bool commit) {
+    if (!overview_active.load(std::memory_order_relaxed)) {
+        ((origRenderMonitor)(g_pRenderMonitorHook->m_original))(thisptr, monitor, commit);
+        return;
+    }
+    TraceScope trace("Overview::hookRenderMonitor");
     WORKSPACEID workspace = monitor->activeSpecialWorkspaceID();
     if (!workspace)
         workspace = monitor->activeWorkspaceID();
@@ -199,6 +234,8 @@ static void hookRenderMonitor(CHyprRenderer *thisptr, PHLMONITOR monitor, bool c
 
 // Needed to render the HW cursor at the right position
 static Vector2D hookGetCursorPosForMonitor(void *thisptr, PHLMONITOR monitor) {
+    if (!overview_active.load(std::memory_order_relaxed))
+        return ((origGetCursorPosForMonitor)(g_pGetCursorPosForMonitorHook->m_original))(thisptr, monitor);
     if (g_pCompositor->m_lastMonitor.lock() != monitor)
         return { 0.0, monitor->m_size.y };
 
@@ -216,22 +253,62 @@ static Vector2D hookGetCursorPosForMonitor(void *thisptr, PHLMONITOR monitor) {
 
 
 
+// Addresses of the hooked functions. Resolving them scans the symbol table of
+// the compositor, so it is done once, on first use (or on warm up), and the
+// result is kept across layout disable/enable cycles.
+static std::unordered_map<std::string, void *> hook_addresses;
+
+static const char *hook_names[] = {
+    "visibleOnMonitor",
+    "renderLayer",
+    "logicalBox",
+    "renderSoftwareCursorsFor",
+    "getMonitorFromVector",
+    "closestValid",
+    "renderMonitor",
+    "getCursorPosForMonitor",
+};
+
+static void *find_hook_address(const std::string &name) {
+    auto it = hook_addresses.find(name);
+    if (it != hook_addresses.end())
+        return it->second;
+    auto FNS = HyprlandAPI::findFunctionsByName(PHANDLE, name);
+    void *address = FNS.empty() ? nullptr : FNS[0].address;
+    hook_addresses[name] = address;
+    return address;
+}
+
 #define DO_HOOK(name_capital, name) do { \
-    auto FNS = HyprlandAPI::findFunctionsByName(PHANDLE, #name); \
-    if (!FNS.empty()) { \
-        g_p ## name_capital ## Hook = HyprlandAPI::createFunctionHook(PHANDLE, FNS[0].address, (bool *)hook ## name_capital); \
+    if (g_p ## name_capital ## Hook == nullptr) { \
+        void *address = find_hook_address(#name); \
+        if (address == nullptr) { \
+            Debug::log(WARN, "[hyprscroller] Overview: Hook of " #name " failed, function not found"); \
+            return false; \
+        } \
+        g_p ## name_capital ## Hook = HyprlandAPI::createFunctionHook(PHANDLE, address, (bool *)hook ## name_capital); \
         if (g_p ## name_capital ## Hook == nullptr) { \
             Debug::log(WARN, "[hyprscroller] Overview: Hook of " #name " failed, function found but hook not successfull"); \
-            return; \
+            return false; \
         } \
-    } else { \
-        Debug::log(WARN, "[hyprscroller] Overview: Hook of " #name " failed, function not found"); \
-        return; \
     } \
 } while (0)
 
 
-Overview::Overview() : initialized(false)
+Overview::Overview() : initialized(false), hooked(false), creation_failed(false)
+{
+}
+
+// Resolves all the addresses without creating the hooks. Can be called at any
+// time, even without an Overview instance.
+void Overview::warm_up()
+{
+    for (auto name : hook_names) {
+        find_hook_address(name);
+    }
+}
+
+bool Overview::create_hooks()
 {
     // Hook bool CWindow::visibleOnMonitor(PHLMONITOR pMonitor)
     DO_HOOK(VisibleOnMonitor, visibleOnMonitor);
@@ -244,12 +321,15 @@ Overview::Overview() : initialized(false)
     DO_HOOK(GetCursorPosForMonitor, getCursorPosForMonitor);
 
     initialized = true;
+    return true;
 }
 
 Overview::~Overview()
 {
-    if (overview_enabled()) {
+    overview_active = false;
+    if (hooked) {
         disable_hooks();
+        hooked = false;
     }
 
     if (g_pClosestValidHook != nullptr) {
@@ -297,14 +377,27 @@ Overview::~Overview()
 
 bool Overview::enable(WORKSPACEID workspace)
 {
-    if (!initialized)
-        return false;
-    if (!overview_enabled()) {
-        if (!enable_hooks())
+    if (!initialized) {
+        // Hooks are created the first time overview is used. If that fails,
+        // don't keep trying on every toggle.
+        if (creation_failed)
+            return false;
+        if (!create_hooks()) {
+            creation_failed = true;
+            return false;
+        }
+    }
+    if (!hooked) {
+        if (!enable_hooks()) {
+            // Some hooks may have been installed before the failure
+            disable_hooks();
             return false;
+        }
+        hooked = true;
     }
     auto &data = data_for(workspace);
     data.overview = true;
+    overview_active = true;
     return true;
 }
 
@@ -320,7 +413,19 @@ void Overview::disable(WORKSPACEID workspace)
         }
     }
     if (!overview_enabled()) {
+        overview_active = false;
+        update_hooks();
+    }
+}
+
+void Overview::update_hooks()
+{
+    // With persistent hooks, the trampolines stay in place and the hooks
+    // fall through to the original functions until the next overview.
+    static auto *const *PERSISTENT = (Hyprlang::INT *const *)HyprlandAPI::getConfigValue(PHANDLE, "plugin:scroller:overview_persistent_hooks")->getDataStaticPtr();
+    if (hooked && !**PERSISTENT && !overview_enabled()) {
         disable_hooks();
+        hooked = false;
     }
 }
 
@@ -342,6 +447,22 @@ void Overview::set_scale(WORKSPACEID workspace, float scale)
     data.scale_i = 1.0f / scale;
 }
 
+void Overview::forget(WORKSPACEID workspace)
+{
+    std::erase_if(_workspaceData, [workspace](const OverviewData &w) {
+        return w.workspace == workspace && !w.overview;
+    });
+}
+
+bool Overview::has_data(WORKSPACEID workspace) const
+{
+    for (auto &w : _workspaceData) {
+        if (w.workspace == workspace)
+            return true;
+    }
+    return false;
+}
+
 Overview::OverviewData& Overview::data_for(WORKSPACEID workspace)
 {
     for (auto &w : _workspaceData) {
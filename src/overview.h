@@ -8,11 +8,18 @@ class Overview {
 public:
     Overview();
     ~Overview();
+    static void warm_up();
     bool is_initialized() const { return initialized; }
     bool enable(WORKSPACEID workspace);
     void disable(WORKSPACEID workspace);
     bool overview_enabled(WORKSPACEID workspace) const;
     void set_scale(WORKSPACEID workspace, float scale);
+    // Removes idle hooks if overview_persistent_hooks has been turned off
+    void update_hooks();
+    // Drops the data of a workspace that is gone, unless it is in overview
+    void forget(WORKSPACEID workspace);
+    bool has_data(WORKSPACEID workspace) const;
+    size_t size() const { return _workspaceData.size(); }
 
     typedef struct {
 	WORKSPACEID workspace;
@@ -24,10 +31,13 @@ public:
 
 private:
     bool overview_enabled() const;
+    bool create_hooks();
     bool enable_hooks();
     void disable_hooks();
 
     bool initialized;
+    bool hooked;    // function hooks currently installed
+    bool creation_failed;
     std::vector<OverviewData> _workspaceData;
 };
 
@@ -0,0 +1,60 @@
+#include "recorder.h"
+
+#include <algorithm>
+#include <bit>
+
+static_assert(std::endian::native == std::endian::little, "the recorder writes its native byte order");
+
+ScrollerRecorder scroller_recorder;
+
+bool ScrollerRecorder::start(const std::string &path)
+{
+    stop();
+    out.open(path, std::ios::binary | std::ios::trunc);
+    if (!out)
+        return false;
+    out.write("HSCR", 4);
+    write<uint32_t>(1);
+    origin = std::chrono::steady_clock::now();
+    recording = true;
+    return true;
+}
+
+void ScrollerRecorder::stop()
+{
+    if (!recording)
+        return;
+    recording = false;
+    out.close();
+}
+
+void ScrollerRecorder::begin(Event event, uint64_t id, std::initializer_list<double> values, uint8_t strings)
+{
+    const auto elapsed = std::chrono::steady_clock::now() - origin;
+    write<uint8_t>(uint8_t(event));
+    write<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    write<uint64_t>(id);
+    write<uint8_t>(values.size());
+    for (auto value : values) {
+        write<double>(value);
+    }
+    write<uint8_t>(strings);
+}
+
+void ScrollerRecorder::add_string(std::string_view str)
+{
+    const uint16_t size = std::min(str.size(), size_t(UINT16_MAX));
+    write<uint16_t>(size);
+    out.write(str.data(), size);
+}
+
+void ScrollerRecorder::record(Event event, uint64_t id, std::initializer_list<double> values,
+                              std::initializer_list<std::string_view> strings)
+{
+    if (!recording)
+        return;
+    begin(event, id, values, strings.size());
+    for (auto str : strings) {
+        add_string(str);
+    }
+}
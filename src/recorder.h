@@ -0,0 +1,58 @@
+#ifndef SCROLLER_RECORDER_H
+#define SCROLLER_RECORDER_H
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+
+// Opt-in log of the inputs that drive the layout, to reproduce a session
+// offline. The file starts with the magic "HSCR" and a u32 version, followed
+// by records, all little endian:
+//   u8  type (ScrollerRecorder::Event)
+//   u64 time, ns since recording started
+//   u64 id (window address or monitor id, 0 if none)
+//   u8  n, followed by n f64 values
+//   u8  m, followed by m strings, each a u16 length and its bytes
+class ScrollerRecorder {
+public:
+    enum class Event : uint8_t {
+        WindowMap = 1,  // values: workspace; strings: class, title, matched rules...
+        WindowUnmap,
+        Focus,
+        Dispatch,       // strings: dispatcher, argument
+        Monitor,        // values: x, y, w, h, scale, reserved tl.x, tl.y, br.x, br.y
+        SwipeBegin,     // values: fingers
+        SwipeUpdate,    // values: fingers, dx, dy
+        SwipeEnd,       // values: cancelled
+    };
+
+    ScrollerRecorder() : recording(false) {}
+    ~ScrollerRecorder() { stop(); }
+
+    bool is_recording() const { return recording; }
+    bool start(const std::string &path);
+    void stop();
+    void record(Event event, uint64_t id, std::initializer_list<double> values,
+                std::initializer_list<std::string_view> strings = {});
+    // For a variable number of strings: while recording, call begin(), then
+    // add_string() for each of them, up to 255.
+    void begin(Event event, uint64_t id, std::initializer_list<double> values, uint8_t strings);
+    void add_string(std::string_view str);
+
+private:
+    template <typename T>
+    void write(T value) {
+        out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+
+    bool recording;
+    std::ofstream out;
+    std::chrono::steady_clock::time_point origin;
+};
+
+extern ScrollerRecorder scroller_recorder;
+
+#endif // SCROLLER_RECORDER_H
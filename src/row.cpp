@@ -5,12 +5,17 @@
 #include <hyprland/src/render/Renderer.hpp>
 #include <hyprland/src/managers/input/InputManager.hpp>
 #include <hyprland/src/managers/LayoutManager.hpp>
+#include <hyprland/src/desktop/Workspace.hpp>
 #include <format>
 
 #include "common.h"
 #include "functions.h"
 #include "row.h"
 #include "overview.h"
+#include "damage.h"
+#include "rules.h"
+#include "trace.h"
+#include "stats.h"
 
 extern HANDLE PHANDLE;
 extern Overview *overviews;
@@ -18,7 +23,7 @@ extern std::function<SDispatchResult(std::string)> orig_moveFocusTo;
 extern ScrollerSizes scroller_sizes;
 
 Row::Row(WORKSPACEID workspace)
-    : workspace(workspace), overview(false),
+    : workspace(workspace), overview(false), scroll_offset(0.0),
       reorder(Reorder::Auto), pinned(nullptr), active(nullptr)
 {
     post_event("overview");
@@ -29,6 +34,12 @@ Row::Row(WORKSPACEID workspace)
 
 Row::~Row()
 {
+    if (scroll_offset != 0.0) {
+        auto PWORKSPACE = g_pCompositor->getWorkspaceByID(workspace);
+        if (PWORKSPACE != nullptr)
+            PWORKSPACE->m_renderOffset->setValueAndWarp(Vector2D(0.0, 0.0));
+        offset_floating_windows(0.0);
+    }
     for (auto col = columns.first(); col != nullptr; col = col->next()) {
         if (col == pinned) {
             col->data()->pin(false);
@@ -38,28 +49,28 @@ Row::~Row()
     columns.clear();
 }
 
-void Row::find_auto_insert_point(Mode &new_mode, ListNode<Column *> *&new_active)
+void Row::find_auto_insert_point(Mode &new_mode, ListNode<Column *> *&new_active) const
 {
     auto auto_mode = modifier.get_auto_mode();
     if (auto_mode == ModeModifier::AUTO_AUTO) {
         auto auto_param = modifier.get_auto_param();
         if (mode == Mode::Row) {
-            if (active->data()->size() < auto_param) {
-                mode = Mode::Column;
+            if (new_active->data()->size() < auto_param) {
+                new_mode = Mode::Column;
                 return;
             }
             // Find another column with less than auto_param windows
             for (auto col = columns.first(); col != nullptr; col = col->next()) {
                 if (col->data()->size() < auto_param) {
-                    mode = Mode::Column;
-                    active = col;
+                    new_mode = Mode::Column;
+                    new_active = col;
                     return;
                 }
             }
         } else {
             // If there are less columns than auto_param, create a new one
             if (columns.size() < auto_param) {
-                mode = Mode::Row;
+                new_mode = Mode::Row;
                 return;
             }
             // Create a new window in the active column only when all the other
@@ -75,8 +86,8 @@ void Row::find_auto_insert_point(Mode &new_mode, ListNode<Column *> *&new_active
             // the window there
             for (auto col = columns.first(); col != nullptr; col = col->next()) {
                 if (col->data()->size() < node->data()->size()) {
-                    mode = Mode::Column;
-                    active = col;
+                    new_mode = Mode::Column;
+                    new_active = col;
                     return;
                 }
             }
@@ -109,33 +120,16 @@ void Row::add_active_window(PHLWINDOW window)
 
     // Evaluate window rules
     auto store_modifier = modifier;
-    for (auto &r: window->m_matchedRules) {
-        if (r->m_rule.starts_with("plugin:scroller:modemodifier")) {
-            const auto modemodifier = r->m_rule.substr(r->m_rule.find_first_of(' ') + 1);
-            // params: row|column after|before|end|beginning focus|nofocus
-            std::istringstream iss(modemodifier);
-            std::string arg;
-            while (iss >> arg) {
-                if (arg == "row") {
-                    mode = Mode::Row;
-                } else if (arg == "col" || arg == "column") {
-                    mode = Mode::Column;
-                } else if (arg == "after") {
-                    modifier.set_position(ModeModifier::POSITION_AFTER);
-                } else if (arg == "before") {
-                    modifier.set_position(ModeModifier::POSITION_BEFORE);
-                } else if (arg == "end") {
-                    modifier.set_position(ModeModifier::POSITION_END);
-                } else if (arg == "beg" || arg == "beginning") {
-                    modifier.set_position(ModeModifier::POSITION_BEGINNING);
-                } else if (arg == "focus") {
-                    modifier.set_focus(ModeModifier::FOCUS_FOCUS);
-                } else if (arg == "nofocus") {
-                    modifier.set_focus(ModeModifier::FOCUS_NOFOCUS);
-                }
-            }
-        }
-    }
+    scroller_rules.for_each(window, [&](const ScrollerRule &rule) {
+        if (rule.type != ScrollerRule::Type::ModeModifier)
+            return;
+        if (rule.mode)
+            mode = *rule.mode;
+        if (rule.position != ModeModifier::POSITION_UNDEFINED)
+            modifier.set_position(rule.position);
+        if (rule.focus != ModeModifier::FOCUS_UNDEFINED)
+            modifier.set_focus(rule.focus);
+    });
 
     auto store_active = active;
     find_auto_insert_point(mode, active);
@@ -184,6 +178,27 @@ void Row::add_active_window(PHLWINDOW window)
         toggle_overview();
 }
 
+// Appends window to the column named group, or to a new last column, and
+// makes it active unless a fullscreen window already is. Nothing is laid
+// out: update_windows() does it once all the windows are in.
+void Row::import_window(PHLWINDOW window, const std::string &group)
+{
+    ListNode<Column *> *node = nullptr;
+    if (!group.empty()) {
+        for (auto c = columns.first(); c != nullptr; c = c->next()) {
+            if (c->data()->get_name() == group) {
+                c->data()->add_active_window(window);
+                node = c;
+                break;
+            }
+        }
+    }
+    if (node == nullptr)
+        node = columns.emplace_after(columns.last(), new Column(window, this));
+    if (active == nullptr || !active->data()->fullscreen())
+        active = node;
+}
+
 // Remove a window and re-adapt rows and columns, returning
 // true if successful, or false if this is the last row
 // so the layout can remove it.
@@ -283,6 +298,11 @@ bool Row::move_focus(Direction dir, bool focus_wrap)
     }
 
     reorder = Reorder::Auto;
+    // Switching tabs in a stacked column doesn't move anything else
+    if ((dir == Direction::Up || dir == Direction::Down) && active->data()->is_stacked() && !overview) {
+        active->data()->recalculate_col_geometry(calculate_gap_x(active), gap, true);
+        return changed_workspace;
+    }
     recalculate_row_geometry();
 
     return changed_workspace;
@@ -343,6 +363,24 @@ Vector2D Row::calculate_gap_x(const ListNode<Column *> *column) const
     return Vector2D(gap0, gap1);
 }
 
+StandardSize Row::next_column_width(Column *column, int step) const
+{
+    StandardSize width = column->get_width();
+    if (width == StandardSize::Free) {
+        // When cycle-resizing from Free mode, move back to closest or default
+        static auto* const *CYCLESIZE_CLOSEST = (Hyprlang::INT* const *)HyprlandAPI::getConfigValue(PHANDLE, "plugin:scroller:cyclesize_closest")->getDataStaticPtr();
+        if (**CYCLESIZE_CLOSEST) {
+            double fraction = column->get_geom_w() / max.w;
+            width = scroller_sizes.get_column_closest_width(g_pCompositor->m_lastMonitor, fraction, step);
+        } else {
+            width = scroller_sizes.get_column_default_width(column->get_active_window());
+        }
+    } else {
+        width = scroller_sizes.get_next_column_width(width, step);
+    }
+    return width;
+}
+
 void Row::resize_active_column(int step)
 {
     if (active->data()->fullscreen())
@@ -355,20 +393,7 @@ void Row::resize_active_column(int step)
     if (mode == Mode::Column) {
         active->data()->cycle_size_active_window(step, calculate_gap_x(active), gap);
     } else {
-        StandardSize width = active->data()->get_width();
-        if (width == StandardSize::Free) {
-            // When cycle-resizing from Free mode, move back to closest or default
-            static auto* const *CYCLESIZE_CLOSEST = (Hyprlang::INT* const *)HyprlandAPI::getConfigValue(PHANDLE, "plugin:scroller:cyclesize_closest")->getDataStaticPtr();
-            if (**CYCLESIZE_CLOSEST) {
-                double fraction = active->data()->get_geom_w() / max.w;
-                width = scroller_sizes.get_column_closest_width(g_pCompositor->m_lastMonitor, fraction, step);
-            } else {
-                width = scroller_sizes.get_column_default_width(get_active_window());
-            }
-        } else {
-            width = scroller_sizes.get_next_column_width(width, step);
-        }
-        active->data()->update_width(width, max.w);
+        active->data()->update_width(next_column_width(active->data(), step), max.w);
         reorder = Reorder::Auto;
         recalculate_row_geometry();
     }
@@ -396,24 +421,90 @@ void Row::size_active_column(StandardSize size)
         toggle_overview();
 }
 
-void Row::size_active_column(const std::string &fraction)
+bool Row::parse_size(const std::string &fraction, StandardSize &size) const
 {
-    StandardSize size;
     if (std::isdigit(fraction.front())) {
         int index = 0;
         try {
             index = std::stoi(fraction);
         } catch (const std::invalid_argument &ia) {
-            return;
+            return false;
         }
         size = mode == Mode::Row ?
-            size = scroller_sizes.get_column_width(index) : size = scroller_sizes.get_window_height(index);
+            scroller_sizes.get_column_width(index) : scroller_sizes.get_window_height(index);
     } else {
         StandardSize default_size = mode == Mode::Row ?
             scroller_sizes.get_column_width(0) : scroller_sizes.get_window_height(0);
         size = scroller_sizes.get_size_from_string(fraction, default_size);
     }
-    size_active_column(size);
+    return true;
+}
+
+void Row::size_active_column(const std::string &fraction)
+{
+    StandardSize size;
+    if (parse_size(fraction, size))
+        size_active_column(size);
+}
+
+// Selection versions of the sizing functions: every column (Row mode) or
+// window (Column mode) with a selection is resized, and the row is laid
+// out once at the end.
+void Row::resize_selection(int step)
+{
+    if (active->data()->fullscreen())
+        return;
+
+    bool overview_on = overview;
+    if (overview)
+        toggle_overview();
+
+    for (auto col = columns.first(); col != nullptr; col = col->next()) {
+        Column *column = col->data();
+        if (!column->has_selection())
+            continue;
+        if (mode == Mode::Column)
+            column->cycle_size_selection(step);
+        else
+            column->update_width(next_column_width(column, step), max.w);
+    }
+    reorder = Reorder::Auto;
+    recalculate_row_geometry();
+
+    if (overview_on)
+        toggle_overview();
+}
+
+void Row::size_selection(StandardSize size)
+{
+    if (active->data()->fullscreen())
+        return;
+
+    bool overview_on = overview;
+    if (overview)
+        toggle_overview();
+
+    for (auto col = columns.first(); col != nullptr; col = col->next()) {
+        Column *column = col->data();
+        if (!column->has_selection())
+            continue;
+        if (mode == Mode::Column)
+            column->size_selection(size);
+        else
+            column->update_width(size, max.w);
+    }
+    reorder = Reorder::Auto;
+    recalculate_row_geometry();
+
+    if (overview_on)
+        toggle_overview();
+}
+
+void Row::size_selection(const std::string &fraction)
+{
+    StandardSize size;
+    if (parse_size(fraction, size))
+        size_selection(size);
 }
 
 void Row::resize_active_window(const Vector2D &delta)
@@ -475,6 +566,16 @@ ModeModifier Row::get_mode_modifier() const
     return modifier;
 }
 
+void Row::get_usage(RowUsage &usage) const
+{
+    usage.bytes += sizeof(Row);
+    for (auto col = columns.first(); col != nullptr; col = col->next()) {
+        ++usage.nodes;
+        usage.bytes += sizeof(ListNode<Column *>);
+        col->data()->get_usage(usage);
+    }
+}
+
 void Row::align_column(Direction dir)
 {
     if (active->data()->fullscreen())
@@ -535,6 +636,15 @@ Column *Row::get_pinned_column() const
     return pinned != nullptr ? pinned->data() : nullptr;
 }
 
+void Row::toggle_stack()
+{
+    if (overview)
+        return;
+    active->data()->toggle_stacked();
+    reorder = Reorder::Auto;
+    recalculate_row_geometry();
+}
+
 void Row::selection_toggle()
 {
     active->data()->selection_toggle();
@@ -554,63 +664,32 @@ void Row::selection_all()
     }
 }
 
-void Row::selection_reset()
-{
-    for (auto col = columns.first(); col != nullptr; col = col->next()) {
-        col->data()->selection_reset();
-    }
-}
-
-static void insert_selection_before(List <Column *> &columns, ListNode<Column *> *node, const List<Column *> &selection)
-{
-    for (auto col = selection.first(); col != nullptr; col = col->next()) {
-        columns.insert_before(node, col->data());
-    }
-}
-
-static void insert_selection_after(List <Column *> &columns, ListNode<Column *> *node, const List<Column *> &selection)
-{
-    for (auto col = selection.last(); col != nullptr; col = col->prev()) {
-        columns.insert_after(node, col->data());
-    }
-}
-
-void Row::selection_move(const List<Column *> &selection, Direction direction)
+// Takes the nodes of selection, leaving it empty
+void Row::selection_move(List<Column *, LayoutHeap> &selection, Direction direction)
 {
     if (columns.size() == 0) {
-        for (auto col = selection.first(); col != nullptr; col = col->next()) {
-            columns.push_back(col->data());
-        }
+        columns.splice_after(nullptr, selection);
         active = columns.first();
     } else {
         switch (direction) {
         case Direction::Left:
-            insert_selection_before(columns, active, selection);
+            columns.splice_before(active, selection);
             break;
         case Direction::Begin:
-            insert_selection_before(columns, columns.first(), selection);
+            columns.splice_before(columns.first(), selection);
             break;
         case Direction::End:
-            insert_selection_after(columns, columns.last(), selection);
+            columns.splice_after(columns.last(), selection);
             break;
         case Direction::Right:
         default:
-            insert_selection_after(columns, active, selection);
+            columns.splice_after(active, selection);
             break;
         }
     }
 }
 
-bool Row::selection_exists() const
-{
-    for (auto col = columns.first(); col != nullptr; col = col->next()) {
-        if (col->data()->selection_exists())
-            return true;
-    }
-    return false;
-}
-
-void Row::selection_get(const Row *row, List<Column *> &selection)
+void Row::selection_get(const Row *row, List<Column *, LayoutHeap> &selection)
 {
     bool overview_on = overview;
     if (overview)
@@ -634,8 +713,9 @@ void Row::selection_get(const Row *row, List<Column *> &selection)
                 if (col == active) {
                     active = active != columns.last() ? active->next() : active->prev();
                 }
+                Column *c = col->data();
                 columns.erase(col);
-                delete col->data();
+                delete c;
             }
         }
         col = next;
@@ -964,29 +1044,113 @@ void Row::expel_window(AdmitExpelDirection dir)
         toggle_overview();
 }
 
+// Size of a window of the given box in the layout, the same as
+// Window::update_window() will set. New windows only have their border.
+static Vector2D window_size_for_box(double w, double h, const Vector2D &gap_x, double gap0, double gap1)
+{
+    static auto PBORDERSIZE = CConfigValue<Hyprlang::INT>("general:border_size");
+    const double border = 2.0 * *PBORDERSIZE;
+    return Vector2D(std::max(w - border - gap_x.x - gap_x.y, 1.0), std::max(h - border - gap0 - gap1, 1.0));
+}
+
+// Dry run of add_active_window() for a window that doesn't exist yet, so
+// it gets its final size in the first configure. Window rules can't be
+// evaluated, so sizes come from the monitor defaults.
 Vector2D Row::predict_window_size() const
 {
-    return Vector2D(0.5 * max.w, max.h);
+    auto monitor = g_pCompositor->m_lastMonitor.lock();
+    if (monitor == nullptr)
+        return {};
+
+    Mode new_mode = mode;
+    ListNode<Column *> *new_active = active;
+    if (active != nullptr)
+        find_auto_insert_point(new_mode, new_active);
+
+    const auto position = modifier.get_position();
+    if (new_active != nullptr && new_mode == Mode::Column) {
+        // It shares the column of new_active
+        const Column *column = new_active->data();
+        double h;
+        if (column->is_stacked())
+            h = max.h;
+        else
+            h = ScrollerSizes::get_fraction(scroller_sizes.get_window_default_height(monitor)) * max.h;
+        double gap0 = gap, gap1 = gap;
+        switch (position) {
+        case ModeModifier::POSITION_AFTER:
+        default:
+            gap1 = column->active_is_last() ? 0.0 : gap;
+            break;
+        case ModeModifier::POSITION_BEFORE:
+            gap0 = column->active_is_first() ? 0.0 : gap;
+            break;
+        case ModeModifier::POSITION_END:
+            gap1 = 0.0;
+            break;
+        case ModeModifier::POSITION_BEGINNING:
+            gap0 = 0.0;
+            break;
+        }
+        if (column->is_stacked())
+            gap0 = gap1 = 0.0;
+        return window_size_for_box(column->get_geom_w(), h, calculate_gap_x(new_active), gap0, gap1);
+    }
+
+    // A new column
+    bool first = new_active == nullptr, last = new_active == nullptr;
+    switch (position) {
+    case ModeModifier::POSITION_AFTER:
+    default:
+        last = last || new_active == columns.last();
+        break;
+    case ModeModifier::POSITION_BEFORE:
+        first = first || new_active == columns.first();
+        break;
+    case ModeModifier::POSITION_END:
+        last = true;
+        break;
+    case ModeModifier::POSITION_BEGINNING:
+        first = true;
+        break;
+    }
+    const Vector2D gap_x(first ? 0.0 : gap, last ? 0.0 : gap);
+    const double w = ScrollerSizes::get_fraction(scroller_sizes.get_column_default_width(monitor)) * max.w;
+    const double h = ScrollerSizes::get_fraction(scroller_sizes.get_window_default_height(monitor)) * max.h;
+    return window_size_for_box(w, h, gap_x, 0.0, 0.0);
+}
+
+// Prediction for the first window of a workspace without a row yet
+Vector2D Row::predict_window_size(WORKSPACEID workspace, PHLMONITOR monitor)
+{
+    Box full, max;
+    int gap;
+    compute_sizes(workspace, monitor, full, max, gap);
+    const double w = ScrollerSizes::get_fraction(scroller_sizes.get_column_default_width(monitor)) * max.w;
+    const double h = ScrollerSizes::get_fraction(scroller_sizes.get_window_default_height(monitor)) * max.h;
+    return window_size_for_box(w, h, Vector2D(0.0, 0.0), 0.0, 0.0);
 }
 
 void Row::post_event(const std::string &event)
 {
     if (event == "mode") {
         auto str_mode = mode == Mode::Row ? "row" : "column";
-        g_pEventManager->postEvent(SHyprIPCEvent{"scroller", std::format("mode, {}, {}, {}, {}:{}, {}, {}", str_mode,
+        post_scroller_event(std::format("mode, {}, {}, {}, {}:{}, {}, {}", str_mode,
             modifier.get_position_string(), modifier.get_focus_string(), modifier.get_auto_mode_string(), modifier.get_auto_param(),
-            modifier.get_center_column_string(), modifier.get_center_window_string())});
+            modifier.get_center_column_string(), modifier.get_center_window_string()));
     } else if (event == "overview") {
-        g_pEventManager->postEvent(SHyprIPCEvent{"scroller", std::format("overview, {}", overview ? 1 : 0)});
+        post_scroller_event(std::format("overview, {}", overview ? 1 : 0));
     } else if (event == "admitwindow") {
-        g_pEventManager->postEvent(SHyprIPCEvent{"scroller", "admitwindow"});
+        post_scroller_event("admitwindow");
     } else if (event == "expelwindow") {
-        g_pEventManager->postEvent(SHyprIPCEvent{"scroller", "expelwindow"});
+        post_scroller_event("expelwindow");
+    } else if (event == "resize") {
+        post_scroller_event(std::format("resize, {}", workspace));
     }
 }
 
 // Returns true/false if columns/windows need to be recalculated
-bool Row::update_sizes(PHLMONITOR monitor)
+void Row::compute_sizes(WORKSPACEID workspace, PHLMONITOR monitor, Box &full, Box &max, int &gap)
 {
     // for gaps outer
     static auto PGAPSINDATA = CConfigValue<Hyprlang::CUSTOMTYPE>("general:gaps_in");
@@ -1003,10 +1167,18 @@ bool Row::update_sizes(PHLMONITOR monitor)
     const auto BOTTOMRIGHT = monitor->m_reservedBottomRight;
 
     full = Box(POS, SIZE);
-    const Box newmax = Box(POS.x + TOPLEFT.x + gaps_out.m_left,
-                           POS.y + TOPLEFT.y + gaps_out.m_top,
-                           SIZE.x - TOPLEFT.x - BOTTOMRIGHT.x - gaps_out.m_left - gaps_out.m_right,
-                           SIZE.y - TOPLEFT.y - BOTTOMRIGHT.y - gaps_out.m_top - gaps_out.m_bottom);
+    max = Box(POS.x + TOPLEFT.x + gaps_out.m_left,
+              POS.y + TOPLEFT.y + gaps_out.m_top,
+              SIZE.x - TOPLEFT.x - BOTTOMRIGHT.x - gaps_out.m_left - gaps_out.m_right,
+              SIZE.y - TOPLEFT.y - BOTTOMRIGHT.y - gaps_out.m_top - gaps_out.m_bottom);
+    gap = gaps_in;
+}
+
+bool Row::update_sizes(PHLMONITOR monitor)
+{
+    Box newmax;
+    int gaps_in;
+    compute_sizes(workspace, monitor, full, newmax, gaps_in);
     bool changed = gap != gaps_in;
     gap = gaps_in;
 
@@ -1073,7 +1245,18 @@ void Row::fit_size(FitSize fitsize)
         return;
     }
     if (mode == Mode::Column) {
-        active->data()->fit_size(fitsize, calculate_gap_x(active), gap);
+        if (fitsize == FitSize::Selection) {
+            for (auto col = columns.first(); col != nullptr; col = col->next()) {
+                if (col->data()->has_selection())
+                    col->data()->fit_size(fitsize, calculate_gap_x(col), gap);
+            }
+        } else {
+            active->data()->fit_size(fitsize, calculate_gap_x(active), gap);
+        }
+        return;
+    }
+    if (fitsize == FitSize::Selection) {
+        fit_selection();
         return;
     }
     ListNode<Column *> *from, *to;
@@ -1144,6 +1327,37 @@ void Row::fit_size(FitSize fitsize)
     }
 }
 
+// Fits the columns from the first to the last selected one, including any
+// unselected columns between them, so none of them is left off screen.
+void Row::fit_selection()
+{
+    ListNode<Column *> *from = nullptr, *to = nullptr;
+    for (auto c = columns.first(); c != nullptr; c = c->next()) {
+        if (!c->data()->has_selection())
+            continue;
+        if (from == nullptr)
+            from = c;
+        to = c;
+    }
+    if (from == nullptr)
+        return;
+
+    double total = 0.0;
+    for (auto c = from; c != to->next(); c = c->next()) {
+        total += c->data()->get_geom_w();
+    }
+    for (auto c = from; c != to->next(); c = c->next()) {
+        Column *col = c->data();
+        col->set_width_free();
+        col->set_geom_w(col->get_geom_w() / total * max.w);
+        double maxw = col->get_geom_w();
+        col->update_width(StandardSize::Free, maxw);
+    }
+    from->data()->set_geom_pos(max.x, max.y);
+
+    adjust_columns(from);
+}
+
 bool Row::is_overview() const
 {
     return overview;
@@ -1151,12 +1365,16 @@ bool Row::is_overview() const
 
 void Row::toggle_overview()
 {
+    TraceScope trace("Row::toggle_overview");
+
     if (columns.size() == 0)
         return;
     auto window = get_active_window();
     if (!window || !window->m_workspace || !window->m_workspace->m_monitor)
         return;
     PHLMONITOR monitor = window->m_workspace->m_monitor.lock();
+    // Only this workspace changes, other monitors don't need to repaint
+    DamageScope damage;
     overview = !overview;
     post_event("overview");
     static auto *const *overview_scale_content = (Hyprlang::INT *const *)HyprlandAPI::getConfigValue(PHANDLE, "plugin:scroller:overview_scale_content")->getDataStaticPtr();
@@ -1204,9 +1422,11 @@ void Row::toggle_overview()
             adjust_overview_columns();
 
             g_pLayoutManager->getCurrentLayout()->recalculateMonitor(monitor->m_id);
-            g_pHyprRenderer->damageMonitor(monitor);
+            // Scaled rendering, boxes don't match what is shown
+            damage_collector.add_monitor(monitor);
             g_pConfigManager->ensureVRR(monitor);
             g_pCompositor->updateSuspendedStates();
+            update_offscreen();
 
             overviews->set_scale(workspace, scale);
         } else {
@@ -1224,11 +1444,13 @@ void Row::toggle_overview()
             overviews->set_scale(workspace, 1.0f);
         }
     } else {
+        // Damage before disabling, it may have been scaled
+        damage_collector.add_monitor(monitor);
         overviews->disable(workspace);
         g_pLayoutManager->getCurrentLayout()->recalculateMonitor(monitor->m_id);
-        g_pHyprRenderer->damageMonitor(monitor);
         g_pConfigManager->ensureVRR(monitor);
         g_pCompositor->updateSuspendedStates();
+        update_offscreen();
         for (auto c = columns.first(); c != nullptr; c = c->next()) {
             Column *col = c->data();
             col->pop_overview_geom();
@@ -1249,10 +1471,6 @@ void Row::toggle_overview()
             toggle_window_fullscreen_internal(window, preoverview_fsmode);
         }
     }
-
-    for (auto const& m : g_pCompositor->m_monitors) {
-        g_pHyprRenderer->damageMonitor(m);
-    }
 }
 
 void Row::update_windows(const Box &oldmax, bool force)
@@ -1280,6 +1498,8 @@ void Row::update_windows(const Box &oldmax, bool force)
 
 void Row::recalculate_row_geometry()
 {
+    TraceScope trace("Row::recalculate_row_geometry");
+
     if (active == nullptr)
         return;
 
@@ -1509,6 +1729,8 @@ void Row::recalculate_row_geometry()
 // Adjust all the columns in the row using 'column' as anchor
 void Row::adjust_columns(ListNode<Column *> *column)
 {
+    TraceScope trace("Row::adjust_columns");
+
     // Adjust the positions of the columns to the left
     for (auto col = column->prev(), prev = column; col != nullptr; prev = col, col = col->prev()) {
         col->data()->set_geom_pos(prev->data()->get_geom_x() - col->data()->get_geom_w(), max.y);
@@ -1525,6 +1747,25 @@ void Row::adjust_columns(ListNode<Column *> *column)
         auto gap1 = col == columns.last() ? 0.0 : gap;
         col->data()->recalculate_col_geometry(Vector2D(gap0, gap1), gap, true);
     }
+    update_offscreen();
+}
+
+// Columns beyond offscreen_suspend_distance from the edges of the viewport
+// have their windows suspended. Target positions are used, so columns are
+// resumed as soon as they start moving back, before they are seen.
+void Row::update_offscreen()
+{
+    static auto* const *DISTANCE = (Hyprlang::INT* const *)HyprlandAPI::getConfigValue(PHANDLE, "plugin:scroller:offscreen_suspend_distance")->getDataStaticPtr();
+    const bool enabled = **DISTANCE >= 0 && !overview;
+    for (auto col = columns.first(); col != nullptr; col = col->next()) {
+        bool offscreen = false;
+        if (enabled) {
+            const double x0 = col->data()->get_geom_x() + scroll_offset;
+            const double x1 = x0 + col->data()->get_geom_w();
+            offscreen = x1 < max.x - **DISTANCE || x0 > max.x + max.w + **DISTANCE;
+        }
+        col->data()->set_offscreen(offscreen);
+    }
 }
 
 // Adjust all the columns in the overview
@@ -1537,6 +1778,8 @@ void Row::adjust_overview_columns()
         auto gap1 = col == columns.last() ? 0.0 : gap;
         col->data()->recalculate_col_geometry_overview(Vector2D(gap0, gap1), gap);
     }
+    // Everything is visible in overview
+    update_offscreen();
 }
 
 // Find the column where the mouse pointer is, or return active
@@ -1555,6 +1798,11 @@ ListNode<Column *> *Row::get_mouse_column() const {
     return column;
 }
 void Row::scroll_update(Direction dir, const Vector2D &delta) {
+    DamageScope damage;
+    auto monitor = g_pCompositor->getWorkspaceByID(workspace)->m_monitor.lock();
+    if (overviews->overview_enabled(workspace))
+        damage_collector.add_monitor(monitor);
+
     switch (dir) {
     case Direction::Up:
     case Direction::Down: {
@@ -1564,6 +1812,19 @@ void Row::scroll_update(Direction dir, const Vector2D &delta) {
     }
     case Direction::Left:
     case Direction::Right: {
+        static auto* const *render_offset = (Hyprlang::INT* const *)HyprlandAPI::getConfigValue(PHANDLE, "plugin:scroller:gesture_scroll_render_offset")->getDataStaticPtr();
+        if (**render_offset) {
+            // Translate the whole workspace while the gesture lasts, without
+            // touching any window. scroll_end() commits the real positions.
+            scroll_offset += delta.x;
+            auto PWORKSPACE = g_pCompositor->getWorkspaceByID(workspace);
+            PWORKSPACE->m_renderOffset->setValueAndWarp(Vector2D(scroll_offset, 0.0));
+            offset_floating_windows(scroll_offset);
+            // Everything on the workspace moves
+            damage_collector.add_monitor(monitor);
+            update_offscreen();
+            break;
+        }
         // Apply column geometry
         for (auto col = columns.first(); col != nullptr; col = col->next()) {
             col->data()->set_geom_pos(col->data()->get_geom_x() + delta.x, max.y);
@@ -1572,18 +1833,51 @@ void Row::scroll_update(Direction dir, const Vector2D &delta) {
             auto gap1 = col == columns.last() ? 0.0 : gap;
             col->data()->recalculate_col_geometry(Vector2D(gap0, gap1), gap, false);
         }
+        update_offscreen();
         break;
     }
     default:
         break;
     }
+}
 
-    auto monitor = g_pCompositor->getWorkspaceByID(workspace)->m_monitor;
-    g_pHyprRenderer->damageMonitor(monitor.lock());
+// Move the columns to where the render offset of a scroll gesture shows them,
+// and remove the offset.
+void Row::commit_scroll_offset()
+{
+    if (scroll_offset == 0.0)
+        return;
+    for (auto col = columns.first(); col != nullptr; col = col->next()) {
+        col->data()->set_geom_pos(col->data()->get_geom_x() + scroll_offset, max.y);
+        auto gap0 = col == columns.first() ? 0.0 : gap;
+        auto gap1 = col == columns.last() ? 0.0 : gap;
+        col->data()->recalculate_col_geometry(Vector2D(gap0, gap1), gap, false);
+    }
+    scroll_offset = 0.0;
+    auto PWORKSPACE = g_pCompositor->getWorkspaceByID(workspace);
+    PWORKSPACE->m_renderOffset->setValueAndWarp(Vector2D(0.0, 0.0));
+    offset_floating_windows(0.0);
+}
+
+// The workspace render offset moves every window of the workspace, but
+// floating windows don't belong to the row: cancel it for them. Pinned
+// windows ignore the workspace offset already.
+void Row::offset_floating_windows(double offset)
+{
+    for (auto &window : g_pCompositor->m_windows) {
+        if (window->workspaceID() != workspace || window->m_pinned || !window->m_isMapped)
+            continue;
+        // Windows that stopped floating during the gesture get their offset back
+        if (window->m_isFloating || offset == 0.0)
+            window->m_floatingOffset = Vector2D(-offset, 0.0);
+    }
 }
 
 void Row::scroll_end(Direction dir)
 {
+    // The direction may have changed during the gesture, commit any
+    // horizontal offset first.
+    commit_scroll_offset();
     if (dir == Direction::Left) {
         auto newactive = columns.last();
         // Take the first after active that has its left edge in the viewport
@@ -1613,5 +1907,6 @@ void Row::scroll_end(Direction dir)
         column->data()->scroll_end(dir, gap);
     }
     recalculate_row_geometry();
+    scroller_stats.count(StatsCounter::FocusWindow);
     g_pCompositor->focusWindow(get_active_window());
 }
@@ -3,7 +3,32 @@
 
 #include "column.h"
 
-class Row {
+// Objects owned by a workspace row, and their estimated size in bytes, for
+// the memory report. Marks, trail marks and overview data are counted in the
+// row of their window or workspace.
+struct RowUsage {
+    size_t columns = 0;
+    size_t windows = 0;
+    size_t nodes = 0;           // list nodes
+    size_t marks = 0;
+    size_t trail_marks = 0;
+    size_t overview = 0;        // overview data entries
+    size_t decorations = 0;     // selection borders and stack tabs
+    size_t bytes = 0;
+
+    void add(const RowUsage &usage) {
+        columns += usage.columns;
+        windows += usage.windows;
+        nodes += usage.nodes;
+        marks += usage.marks;
+        trail_marks += usage.trail_marks;
+        overview += usage.overview;
+        decorations += usage.decorations;
+        bytes += usage.bytes;
+    }
+};
+
+class Row : public AllocCounted<AllocSubsystem::Row> {
 public:
     Row(WORKSPACEID workspace);
     ~Row();
@@ -33,7 +58,15 @@ public:
             col->data()->get_windows(windows);
         }
     }
+    // Adds the columns and windows of the row to usage
+    void get_usage(RowUsage &usage) const;
+    void get_shown_windows(std::vector<PHLWINDOWREF> &windows) {
+        for (auto col = columns.first(); col != nullptr; col = col->next()) {
+            col->data()->get_shown_windows(windows);
+        }
+    }
     void add_active_window(PHLWINDOW window);
+    void import_window(PHLWINDOW window, const std::string &group);
     // Remove a window and re-adapt rows and columns, returning
     // true if successful, or false if this is the last row
     // so the layout can remove it.
@@ -43,28 +76,30 @@ public:
 
     void resize_active_column(int step);
     void size_active_column(const std::string &arg);
+    void resize_selection(int step);
+    void size_selection(const std::string &arg);
     void resize_active_window(const Vector2D &delta);
     void set_mode(Mode m, bool silent = false);
     Mode get_mode() const;
     void set_mode_modifier(const ModeModifier &m);
     ModeModifier get_mode_modifier() const;
-    void find_auto_insert_point(Mode &new_mode, ListNode<Column *> *&new_active);
+    void find_auto_insert_point(Mode &new_mode, ListNode<Column *> *&new_active) const;
     void align_column(Direction dir);
     void pin();
     Column *get_pinned_column() const;
+    void toggle_stack();
     void selection_toggle();
     void selection_set(PHLWINDOWREF window);
     void selection_all();
-    void selection_reset();
-    void selection_move(const List<Column *> &columns, Direction direction);
-    void selection_get(const Row *row, List<Column *> &selection);
-    bool selection_exists() const;
+    void selection_move(List<Column *, LayoutHeap> &columns, Direction direction);
+    void selection_get(const Row *row, List<Column *, LayoutHeap> &selection);
     void move_active_window_to_group(const std::string &name);
     void move_active_column(Direction dir);
     void move_active_window(Direction dir);
     void admit_window(AdmitExpelDirection dir);
     void expel_window(AdmitExpelDirection dir);
     Vector2D predict_window_size() const;
+    static Vector2D predict_window_size(WORKSPACEID workspace, PHLMONITOR monitor);
     void post_event(const std::string &event);
     // Returns the old viewport
     bool update_sizes(PHLMONITOR monitor);
@@ -78,8 +113,11 @@ public:
 
     void scroll_update(Direction dir, const Vector2D &delta);
     void scroll_end(Direction dir);
+    // Suspend the windows of columns far from the viewport
+    void update_offscreen();
 
 private:
+    void offset_floating_windows(double offset);
     bool move_focus_left(bool focus_wrap); 
     bool move_focus_right(bool focus_wrap);
     void move_focus_begin();
@@ -92,20 +130,27 @@ private:
     // Adjust all the columns in the overview
     void adjust_overview_columns();
     void size_active_column(StandardSize size);
+    static void compute_sizes(WORKSPACEID workspace, PHLMONITOR monitor, Box &full, Box &max, int &gap);
+    void size_selection(StandardSize size);
+    bool parse_size(const std::string &fraction, StandardSize &size) const;
+    StandardSize next_column_width(Column *column, int step) const;
+    void fit_selection();
     ListNode<Column *> *get_mouse_column() const;
+    void commit_scroll_offset();
 
     WORKSPACEID workspace;
     Box full;
     Box max;
     bool overview;
     eFullscreenMode preoverview_fsmode;
+    double scroll_offset;   // horizontal render offset of a scroll gesture
     int gap;
     Reorder reorder;
     Mode mode;
     ModeModifier modifier;
     ListNode<Column *> *pinned;
     ListNode<Column *> *active;
-    List<Column *> columns;
+    List<Column *, LayoutHeap> columns;
 };
 
 #endif // SCROLLER_ROW_H
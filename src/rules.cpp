@@ -0,0 +1,90 @@
+#include "rules.h"
+
+#include <sstream>
+
+#include "allocs.h"
+
+extern ScrollerSizes scroller_sizes;
+
+ScrollerRules scroller_rules;
+
+const ScrollerRule &ScrollerRules::get(const void *id, const std::string &text)
+{
+    auto it = cache.find(id);
+    if (it != cache.end() && it->second.text == text)
+        return it->second.rule;
+
+    auto &entry = cache[id];
+    entry.text = text;
+    entry.rule = compile(text);
+    return entry.rule;
+}
+
+static Direction parse_align_direction(const std::string &dir)
+{
+    if (dir == "l" || dir == "left") {
+        return Direction::Left;
+    } else if (dir == "r" || dir == "right") {
+        return Direction::Right;
+    } else if (dir == "u" || dir == "up") {
+        return Direction::Up;
+    } else if (dir == "d" || dir == "dn" || dir == "down") {
+        return Direction::Down;
+    } else if (dir == "c" || dir == "centre" || dir == "center") {
+        return Direction::Center;
+    } else if (dir == "m" || dir == "middle") {
+        return Direction::Middle;
+    }
+    return Direction::Invalid;
+}
+
+ScrollerRule ScrollerRules::compile(const std::string &text)
+{
+    ScrollerRule rule;
+    if (!text.starts_with("plugin:scroller:"))
+        return rule;
+
+    const auto arg = text.substr(text.find_first_of(' ') + 1);
+    scroller_allocs.add_string(AllocSubsystem::Rules, arg);
+    if (text.starts_with("plugin:scroller:group")) {
+        rule.type = ScrollerRule::Type::Group;
+        rule.name = arg;
+    } else if (text.starts_with("plugin:scroller:alignwindow")) {
+        rule.type = ScrollerRule::Type::AlignWindow;
+        rule.direction = parse_align_direction(arg);
+    } else if (text.starts_with("plugin:scroller:marksadd")) {
+        rule.type = ScrollerRule::Type::MarksAdd;
+        rule.name = arg;
+    } else if (text.starts_with("plugin:scroller:modemodifier")) {
+        rule.type = ScrollerRule::Type::ModeModifier;
+        // params: row|column after|before|end|beginning focus|nofocus
+        std::istringstream iss(arg);
+        std::string param;
+        while (iss >> param) {
+            if (param == "row") {
+                rule.mode = Mode::Row;
+            } else if (param == "col" || param == "column") {
+                rule.mode = Mode::Column;
+            } else if (param == "after") {
+                rule.position = ModeModifier::POSITION_AFTER;
+            } else if (param == "before") {
+                rule.position = ModeModifier::POSITION_BEFORE;
+            } else if (param == "end") {
+                rule.position = ModeModifier::POSITION_END;
+            } else if (param == "beg" || param == "beginning") {
+                rule.position = ModeModifier::POSITION_BEGINNING;
+            } else if (param == "focus") {
+                rule.focus = ModeModifier::FOCUS_FOCUS;
+            } else if (param == "nofocus") {
+                rule.focus = ModeModifier::FOCUS_NOFOCUS;
+            }
+        }
+    } else if (text.starts_with("plugin:scroller:columnwidth")) {
+        rule.type = ScrollerRule::Type::ColumnWidth;
+        rule.size = scroller_sizes.get_size_from_string(arg, StandardSize::OneHalf);
+    } else if (text.starts_with("plugin:scroller:windowheight")) {
+        rule.type = ScrollerRule::Type::WindowHeight;
+        rule.size = scroller_sizes.get_size_from_string(arg, StandardSize::One);
+    }
+    return rule;
+}
@@ -0,0 +1,61 @@
+#ifndef SCROLLER_RULES_H
+#define SCROLLER_RULES_H
+
+#include <hyprland/src/desktop/Window.hpp>
+
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include "enums.h"
+#include "sizes.h"
+
+// A plugin:scroller:* window rule, parsed into the action it describes.
+struct ScrollerRule {
+    enum class Type { None, Group, AlignWindow, MarksAdd, ModeModifier, ColumnWidth, WindowHeight };
+
+    Type type = Type::None;
+    std::string name;                           // Group, MarksAdd
+    Direction direction = Direction::Invalid;   // AlignWindow
+    std::optional<Mode> mode;                   // ModeModifier
+    int position = ModeModifier::POSITION_UNDEFINED;
+    int focus = ModeModifier::FOCUS_UNDEFINED;
+    StandardSize size = StandardSize::Free;     // ColumnWidth, WindowHeight
+};
+
+// Window rules are matched again on every map, but their text only changes
+// with the configuration, so each rule is parsed once and its action kept
+// until the next config reload. Entries are keyed by rule identity and keep
+// the rule text, so a rule replaced at the same address is parsed again.
+class ScrollerRules {
+public:
+    ScrollerRules() {}
+    ~ScrollerRules() {}
+
+    // Calls f(const ScrollerRule &) for each plugin rule matched by window,
+    // in matching order.
+    template <typename F>
+    void for_each(PHLWINDOW window, F &&f) {
+        for (auto &r: window->m_matchedRules) {
+            const ScrollerRule &rule = get(r.get(), r->m_rule);
+            if (rule.type != ScrollerRule::Type::None)
+                f(rule);
+        }
+    }
+    void clear() { cache.clear(); }
+
+private:
+    struct Entry {
+        std::string text;
+        ScrollerRule rule;
+    };
+
+    const ScrollerRule &get(const void *id, const std::string &text);
+    static ScrollerRule compile(const std::string &text);
+
+    std::unordered_map<const void *, Entry> cache;
+};
+
+extern ScrollerRules scroller_rules;
+
+#endif // SCROLLER_RULES_H
@@ -8,7 +8,9 @@
 #include <hyprland/src/managers/EventManager.hpp>
 #include <hyprland/src/plugins/PluginAPI.hpp>
 #include <hyprland/src/render/Renderer.hpp>
+#include <hyprland/src/render/OpenGL.hpp>
 #include <hyprland/src/managers/input/InputManager.hpp>
+#include <hyprland/src/managers/eventLoop/EventLoopManager.hpp>
 
 #include "scroller.h"
 #include "common.h"
@@ -16,7 +18,14 @@
 #include "row.h"
 #include "column.h"
 #include "overview.h"
-
+#include "damage.h"
+#include "rules.h"
+#include "stats.h"
+#include "allocs.h"
+#include "recorder.h"
+
+#include <algorithm>
+#include <deque>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -74,15 +83,23 @@ public:
         return nullptr;
     }
 
+    // Calls f(name, window) for every mark
+    template <typename F>
+    void for_each(F f) const {
+        for (const auto &[name, window] : marks) {
+            f(name, window.lock());
+        }
+    }
+
     void post_mark_event(PHLWINDOW window) {
         bool marked = false;
         for(auto it = marks.begin(); it != marks.end(); it++) {
             if (it->second.lock() == window) {
-                g_pEventManager->postEvent(SHyprIPCEvent{"scroller", std::format("mark, 1, {}", it->first)});
+                post_scroller_event(std::format("mark, 1, {}", it->first));
                 return;
             }
         }
-        g_pEventManager->postEvent(SHyprIPCEvent{"scroller", "mark, 0, "});
+        post_scroller_event("mark, 0, ");
     }
 
 private:
@@ -152,10 +169,6 @@ protected:
         for (auto win = marks.first(); win != nullptr; win = win->next()) {
             g_ScrollerLayout->selection_set(win->data());
         }
-        // Re-render windows to show decorations
-        for (auto monitor : g_pCompositor->m_monitors) {
-            g_pHyprRenderer->damageMonitor(monitor);
-        }
     }
 
 private:
@@ -224,8 +237,8 @@ public:
         if (active == nullptr)
             return;
         auto act = active == trails.first() ? active->next() : active->prev();
-        trails.erase(active);
         delete active->data();
+        trails.erase(active);
         active = act;
         post_trail_event();
     }
@@ -261,14 +274,25 @@ public:
         active->data()->prev();
     }
 
+    size_t size() const { return trails.size(); }
+    // Calls f(window) for every mark of every trail
+    template <typename F>
+    void for_each_mark(F f) const {
+        for (auto trail = trails.first(); trail != nullptr; trail = trail->next()) {
+            for (auto mark = trail->data()->marks.first(); mark != nullptr; mark = mark->next()) {
+                f(mark->data().lock());
+            }
+        }
+    }
+
     void post_trail_event() {
-        g_pEventManager->postEvent(SHyprIPCEvent{"scroller", std::format("trail, {}, {}", get_active_number(), get_active_size())});
+        post_scroller_event(std::format("trail, {}, {}", get_active_number(), get_active_size()));
     }
     void post_trailmark_event(PHLWINDOW window) {
         bool marked = false;
         if (active != nullptr && active->data()->is_marked(window))
             marked = true;
-        g_pEventManager->postEvent(SHyprIPCEvent{"scroller", std::format("trailmark, {}", marked ? 1 : 0)});
+        post_scroller_event(std::format("trailmark, {}", marked ? 1 : 0));
     }
 
 private:
@@ -280,6 +304,15 @@ private:
 static Trails *trails;
 
 // ScrollerLayout
+void ScrollerLayout::delete_row(ListNode<Row *> *row) {
+    Row *s = row->data();
+    rows.erase(row);
+    // Workspaces come and go, don't keep their overview data
+    if (overviews != nullptr)
+        overviews->forget(s->get_workspace());
+    delete s;
+}
+
 Row *ScrollerLayout::getRowForWorkspace(WORKSPACEID workspace) {
     for (auto row = rows.first(); row != nullptr; row = row->next()) {
         if (row->data()->get_workspace() == workspace)
@@ -303,6 +336,19 @@ Row *ScrollerLayout::getRowForWindow(PHLWINDOW window) {
 */
 void ScrollerLayout::onWindowCreatedTiling(PHLWINDOW window, eDirection)
 {
+    static StatsOperation *stats = scroller_stats.get("onWindowCreatedTiling");
+    StatsScope scope(stats);
+    if (scroller_recorder.is_recording()) {
+        const size_t rules = std::min(window->m_matchedRules.size(), size_t(253));
+        scroller_recorder.begin(ScrollerRecorder::Event::WindowMap, reinterpret_cast<uintptr_t>(window.get()),
+                                { double(window->workspaceID()) }, rules + 2);
+        scroller_recorder.add_string(window->m_class);
+        scroller_recorder.add_string(window->m_title);
+        for (size_t i = 0; i < rules; ++i) {
+            scroller_recorder.add_string(window->m_matchedRules[i]->m_rule);
+        }
+    }
+
     WORKSPACEID wid = window->workspaceID();
     auto s = getRowForWorkspace(wid);
     if (s == nullptr) {
@@ -317,30 +363,22 @@ void ScrollerLayout::onWindowCreatedTiling(PHLWINDOW window, eDirection)
     s->add_active_window(window);
 
     // Check window rules
-    for (auto &r: window->m_matchedRules) {
-        if (r->m_rule.starts_with("plugin:scroller:group")) {
-            const auto name = r->m_rule.substr(r->m_rule.find_first_of(' ') + 1);
-            s->move_active_window_to_group(name);
-        } else if (r->m_rule.starts_with("plugin:scroller:alignwindow")) {
-            const auto dir = r->m_rule.substr(r->m_rule.find_first_of(' ') + 1);
-            if (dir == "l" || dir == "left") {
-                s->align_column(Direction::Left);
-            } else if (dir == "r" || dir == "right") {
-                s->align_column(Direction::Right);
-            } else if (dir == "u" || dir == "up") {
-                s->align_column(Direction::Up);
-            } else if (dir == "d" || dir == "dn" || dir == "down") {
-                s->align_column(Direction::Down);
-            } else if (dir == "c" || dir == "centre" || dir == "center") {
-                s->align_column(Direction::Center);
-            } else if (dir == "m" || dir == "middle") {
-                s->align_column(Direction::Middle);
-            }
-        } else if (r->m_rule.starts_with("plugin:scroller:marksadd")) {
-            const auto mark_name = r->m_rule.substr(r->m_rule.find_first_of(' ') + 1);
-            marks.add(window, mark_name);
+    scroller_rules.for_each(window, [&](const ScrollerRule &rule) {
+        switch (rule.type) {
+        case ScrollerRule::Type::Group:
+            s->move_active_window_to_group(rule.name);
+            break;
+        case ScrollerRule::Type::AlignWindow:
+            if (rule.direction != Direction::Invalid)
+                s->align_column(rule.direction);
+            break;
+        case ScrollerRule::Type::MarksAdd:
+            marks.add(window, rule.name);
+            break;
+        default:
+            break;
         }
-    }
+    });
 }
 
 /*
@@ -356,6 +394,10 @@ void ScrollerLayout::onWindowCreatedTiling(PHLWINDOW window, eDirection)
 */
 void ScrollerLayout::onWindowRemovedTiling(PHLWINDOW window)
 {
+    static StatsOperation *stats = scroller_stats.get("onWindowRemovedTiling");
+    StatsScope scope(stats);
+    scroller_recorder.record(ScrollerRecorder::Event::WindowUnmap, reinterpret_cast<uintptr_t>(window.get()), {});
+
     auto s = getRowForWindow(window);
     if (s == nullptr)
         return;
@@ -367,8 +409,7 @@ void ScrollerLayout::onWindowRemovedTiling(PHLWINDOW window)
         // It was the last one, remove the row
         for (auto row = rows.first(); row != nullptr; row = row->next()) {
             if (row->data() == s) {
-                rows.erase(row);
-                delete row->data();
+                delete_row(row);
                 break;
             }
         }
@@ -409,8 +450,10 @@ void ScrollerLayout::onWindowRemovedFloating(PHLWINDOW window)
         workspace_id = g_pCompositor->m_lastMonitor->activeWorkspaceID();
     }
     auto s = getRowForWorkspace(workspace_id);
-    if (s != nullptr)
+    if (s != nullptr) {
+        scroller_stats.count(StatsCounter::FocusWindow);
         g_pCompositor->focusWindow(s->get_active_window());
+    }
 }
 
 /*
@@ -418,6 +461,10 @@ void ScrollerLayout::onWindowRemovedFloating(PHLWINDOW window)
 */
 void ScrollerLayout::onWindowFocusChange(PHLWINDOW window)
 {
+    static StatsOperation *stats = scroller_stats.get("onWindowFocusChange");
+    StatsScope scope(stats);
+    scroller_recorder.record(ScrollerRecorder::Event::Focus, reinterpret_cast<uintptr_t>(window.get()), {});
+
     if (window == nullptr) { // no window has focus
         return;
     }
@@ -443,11 +490,20 @@ bool ScrollerLayout::isWindowTiled(PHLWINDOW window)
 */
 void ScrollerLayout::recalculateMonitor(const MONITORID &monitor_id)
 {
+    static StatsOperation *stats = scroller_stats.get("recalculateMonitor");
+    StatsScope scope(stats);
+
     const auto PMONITOR = g_pCompositor->getMonitorFromID(monitor_id);
     if (!PMONITOR)
         return;
 
-    g_pHyprRenderer->damageMonitor(PMONITOR);
+    scroller_recorder.record(ScrollerRecorder::Event::Monitor, monitor_id,
+                             { PMONITOR->m_position.x, PMONITOR->m_position.y, PMONITOR->m_size.x, PMONITOR->m_size.y, PMONITOR->m_scale,
+                               PMONITOR->m_reservedTopLeft.x, PMONITOR->m_reservedTopLeft.y,
+                               PMONITOR->m_reservedBottomRight.x, PMONITOR->m_reservedBottomRight.y });
+
+    // Damage only what moves, unless a workspace is in scaled overview
+    DamageScope damage;
 
     WORKSPACEID specialID = PMONITOR->activeSpecialWorkspaceID();
     if (specialID) {
@@ -455,6 +511,8 @@ void ScrollerLayout::recalculateMonitor(const MONITORID &monitor_id)
         if (sw == nullptr) {
             return;
         }
+        if (overviews != nullptr && overviews->overview_enabled(specialID))
+            damage_collector.add_monitor(PMONITOR);
         const Box oldmax = sw->get_max();
         const bool force = sw->update_sizes(PMONITOR);
         auto PWORKSPACESPECIAL = PMONITOR->m_activeSpecialWorkspace;
@@ -472,6 +530,8 @@ void ScrollerLayout::recalculateMonitor(const MONITORID &monitor_id)
     auto s = getRowForWorkspace(PWORKSPACE->m_id);
     if (s == nullptr)
         return;
+    if (overviews != nullptr && overviews->overview_enabled(PWORKSPACE->m_id))
+        damage_collector.add_monitor(PMONITOR);
 
     const Box oldmax = s->get_max();
     const bool force = s->update_sizes(PMONITOR);
@@ -488,9 +548,15 @@ void ScrollerLayout::recalculateMonitor(const MONITORID &monitor_id)
 */
 void ScrollerLayout::recalculateWindow(PHLWINDOW window)
 {
+    static StatsOperation *stats = scroller_stats.get("recalculateWindow");
+    StatsScope scope(stats);
+
     // It can get called after windows are already being destroyed (decorations update)
     if (!enabled)
         return;
+    // Selection borders don't change the layout
+    if (Window::is_updating_decoration())
+        return;
 
     auto s = getRowForWindow(window);
     if (s == nullptr)
@@ -507,11 +573,16 @@ void ScrollerLayout::recalculateWindow(PHLWINDOW window)
 void ScrollerLayout::resizeActiveWindow(const Vector2D &delta,
                                         eRectCorner /* corner */, PHLWINDOW window)
 {
+    static StatsOperation *stats = scroller_stats.get("resizeActiveWindow");
+    StatsScope scope(stats);
+
     const auto PWINDOW = window ? window : g_pCompositor->m_lastWindow.lock();
     auto s = getRowForWindow(PWINDOW);
     if (s == nullptr) {
         // Window is not tiled
         *PWINDOW->m_realSize = Vector2D(std::max((PWINDOW->m_realSize->goal() + delta).x, 20.0), std::max((PWINDOW->m_realSize->goal() + delta).y, 20.0));
+        scroller_stats.count(StatsCounter::AnimatedWrite);
+        scroller_stats.count(StatsCounter::SendWindowSize);
         PWINDOW->sendWindowSize();
         PWINDOW->updateWindowDecos();
         return;
@@ -529,6 +600,9 @@ void ScrollerLayout::fullscreenRequestForWindow(PHLWINDOW window,
                                                 const eFullscreenMode CURRENT_EFFECTIVE_MODE,
                                                 const eFullscreenMode EFFECTIVE_MODE)
 {
+    static StatsOperation *stats = scroller_stats.get("fullscreenRequestForWindow");
+    StatsScope scope(stats);
+
     auto s = getRowForWindow(window);
 
     if (s == nullptr) {
@@ -545,6 +619,8 @@ void ScrollerLayout::fullscreenRequestForWindow(PHLWINDOW window,
                 // get back its' dimensions from position and size
                 *window->m_realPosition = window->m_lastFloatingPosition;
                 *window->m_realSize     = window->m_lastFloatingSize;
+                scroller_stats.count(StatsCounter::AnimatedWrite, 2);
+                scroller_stats.count(StatsCounter::SendWindowSize);
 
                 window->unsetWindowData(PRIORITY_LAYOUT);
                 window->updateWindowData();
@@ -556,11 +632,14 @@ void ScrollerLayout::fullscreenRequestForWindow(PHLWINDOW window,
             if (EFFECTIVE_MODE == FSMODE_FULLSCREEN) {
                 *window->m_realPosition = PMONITOR->m_position;
                 *window->m_realSize     = PMONITOR->m_size;
+                scroller_stats.count(StatsCounter::AnimatedWrite, 2);
             } else {
                 Box box = { PMONITOR->m_position + PMONITOR->m_reservedTopLeft,
                             PMONITOR->m_size - PMONITOR->m_reservedTopLeft - PMONITOR->m_reservedBottomRight};
                 *window->m_realPosition = Vector2D(box.x, box.y);
                 *window->m_realSize = Vector2D(box.w, box.h);
+                scroller_stats.count(StatsCounter::AnimatedWrite, 2);
+                scroller_stats.count(StatsCounter::SendWindowSize);
                 window->sendWindowSize();
             }
         }
@@ -684,6 +763,7 @@ static SP<HOOK_CALLBACK_FN> swipeBeginHookCallback;
 static SP<HOOK_CALLBACK_FN> swipeUpdateHookCallback;
 static SP<HOOK_CALLBACK_FN> swipeEndHookCallback;
 static SP<HOOK_CALLBACK_FN> mouseMoveHookCallback;
+static SP<HOOK_CALLBACK_FN> configReloadedHookCallback;
 
 void ScrollerLayout::onEnable() {
     // Hijack Hyprland's default dispatchers
@@ -697,6 +777,14 @@ void ScrollerLayout::onEnable() {
         auto WORKSPACE = std::any_cast<PHLWORKSPACE>(param);
         post_event(WORKSPACE->m_id, "mode");
         post_event(WORKSPACE->m_id, "overview");
+        // The switch resets suspended states, suspend far columns again
+        // once it is done
+        const WORKSPACEID workspace = WORKSPACE->m_id;
+        g_pEventLoopManager->doLater([this, workspace]() {
+            auto s = getRowForWorkspace(workspace);
+            if (s != nullptr)
+                s->update_offscreen();
+        });
     });
     focusedMonHookCallback = HyprlandAPI::registerCallbackDynamic(PHANDLE, "focusedMon", [&](void* /* self */, SCallbackInfo& /* info */, std::any param) {
         auto monitor = std::any_cast<PHLMONITOR>(param);
@@ -711,16 +799,23 @@ void ScrollerLayout::onEnable() {
 
     swipeBeginHookCallback = HyprlandAPI::registerCallbackDynamic(PHANDLE, "swipeBegin", [&](void* /* self */, SCallbackInfo& /* info */, std::any param) {
         auto swipe_event = std::any_cast<IPointer::SSwipeBeginEvent>(param);
+        scroller_recorder.record(ScrollerRecorder::Event::SwipeBegin, 0, { double(swipe_event.fingers) });
         swipe_begin(swipe_event);
     });
 
     swipeUpdateHookCallback = HyprlandAPI::registerCallbackDynamic(PHANDLE, "swipeUpdate", [&](void* /* self */, SCallbackInfo& info, std::any param) {
+        static StatsOperation *stats = scroller_stats.get("swipeUpdate");
+        StatsScope scope(stats);
         auto swipe_event = std::any_cast<IPointer::SSwipeUpdateEvent>(param);
+        scroller_recorder.record(ScrollerRecorder::Event::SwipeUpdate, 0, { double(swipe_event.fingers), swipe_event.delta.x, swipe_event.delta.y });
         swipe_update(info, swipe_event);
     });
 
     swipeEndHookCallback = HyprlandAPI::registerCallbackDynamic(PHANDLE, "swipeEnd", [&](void* /* self */, SCallbackInfo& info, std::any param) {
+        static StatsOperation *stats = scroller_stats.get("swipeEnd");
+        StatsScope scope(stats);
         auto swipe_event = std::any_cast<IPointer::SSwipeEndEvent>(param);
+        scroller_recorder.record(ScrollerRecorder::Event::SwipeEnd, 0, { swipe_event.cancelled ? 1.0 : 0.0 });
         swipe_end(info, swipe_event);
     });
 
@@ -729,18 +824,67 @@ void ScrollerLayout::onEnable() {
         mouse_move(info, mousePos);
     });
 
+    configReloadedHookCallback = HyprlandAPI::registerCallbackDynamic(PHANDLE, "configReloaded", [&](void* /* self */, SCallbackInfo& /* info */, std::any /* param */) {
+        // Fonts or colors may have changed
+        jump_labels_cache_clear();
+        // Window rules may have changed
+        scroller_rules.clear();
+        // overview_persistent_hooks may have been turned off
+        if (overviews != nullptr)
+            overviews->update_hooks();
+    });
+
     enabled = true;
     overviews = new Overview;
+    // Overview hooks are resolved on first use. Optionally, resolve them once
+    // the event loop is idle, so the first overview doesn't pay for it.
+    static auto* const *OVERVIEW_WARMUP = (Hyprlang::INT* const *)HyprlandAPI::getConfigValue(PHANDLE, "plugin:scroller:overview_warmup")->getDataStaticPtr();
+    if (**OVERVIEW_WARMUP) {
+        g_pEventLoopManager->doLater([]() { Overview::warm_up(); });
+    }
     marks.reset();
     trails = new Trails();
+    import_windows();
+}
+
+// Builds the rows of the windows that are already open, then lays out each
+// row once, with the sizes of its own monitor.
+void ScrollerLayout::import_windows()
+{
     for (auto& window : g_pCompositor->m_windows) {
         if (window->m_isFloating || !window->m_isMapped || window->isHidden())
             continue;
 
-        onWindowCreatedTiling(window);
+        WORKSPACEID wid = window->workspaceID();
+        auto s = getRowForWorkspace(wid);
+        if (s == nullptr) {
+            s = new Row(wid);
+            rows.push_back(s);
+        }
+        window->unsetWindowData(PRIORITY_LAYOUT);
+        window->updateWindowData();
+
+        std::string group;
+        scroller_rules.for_each(window, [&](const ScrollerRule &rule) {
+            if (rule.type == ScrollerRule::Type::Group)
+                group = rule.name;
+            else if (rule.type == ScrollerRule::Type::MarksAdd)
+                marks.add(window, rule.name);
+        });
+        s->import_window(window, group);
     }
-    for (auto &monitor : g_pCompositor->m_monitors) {
-        recalculateMonitor(monitor->m_id);
+
+    DamageScope damage;
+    for (auto row = rows.first(); row != nullptr; row = row->next()) {
+        Row *s = row->data();
+        auto PWORKSPACE = g_pCompositor->getWorkspaceByID(s->get_workspace());
+        auto monitor = PWORKSPACE != nullptr ? PWORKSPACE->m_monitor.lock() : nullptr;
+        const Box oldmax = s->get_max();
+        if (monitor != nullptr)
+            s->update_sizes(monitor);
+        s->update_windows(oldmax, true);
+        if (PWORKSPACE != nullptr && PWORKSPACE->m_hasFullscreenWindow)
+            s->set_fullscreen_mode_windows(PWORKSPACE->m_fullscreenMode);
     }
 }
 
@@ -778,12 +922,20 @@ void ScrollerLayout::onDisable() {
         mouseMoveHookCallback.reset();
         mouseMoveHookCallback = nullptr;
     }
+    if (configReloadedHookCallback != nullptr) {
+        configReloadedHookCallback.reset();
+        configReloadedHookCallback = nullptr;
+    }
+    jump_labels_cache_clear();
+    scroller_rules.clear();
+    scroller_recorder.stop();
 
     if (overviews != nullptr) {
         delete overviews;
         overviews = nullptr;
     }
     enabled = false;
+    // Deleting the windows also resumes those suspended for being offscreen
     for (auto row = rows.first(); row != nullptr; row = row->next()) {
         delete row->data();
     }
@@ -803,85 +955,113 @@ Vector2D ScrollerLayout::predictSizeForNewWindowTiled() {
 
     WORKSPACEID workspace_id = g_pCompositor->m_lastMonitor->activeWorkspaceID();
     auto s = getRowForWorkspace(workspace_id);
-    if (s == nullptr) {
-        Vector2D size =g_pCompositor->m_lastMonitor->m_size;
-        size.x *= 0.5;
-        return size;
-    }
+    if (s == nullptr)
+        return Row::predict_window_size(workspace_id, g_pCompositor->m_lastMonitor.lock());
 
     return s->predict_window_size();
 }
 
-void ScrollerLayout::cycle_window_size(WORKSPACEID workspace, int step)
+// Rows affected by a sizing dispatcher: the one for workspace, or every
+// row owning selected windows, in the order of rows
+std::vector<Row *> ScrollerLayout::get_target_rows(WORKSPACEID workspace, bool selection)
 {
-    auto s = getRowForWorkspace(workspace);
-    if (s == nullptr) {
-        return;
+    std::vector<Row *> targets;
+    if (selection) {
+        const auto ids = scroller_selection.workspaces();
+        for (auto row = rows.first(); row != nullptr; row = row->next()) {
+            if (std::find(ids.begin(), ids.end(), row->data()->get_workspace()) != ids.end())
+                targets.push_back(row->data());
+        }
+    } else {
+        auto s = getRowForWorkspace(workspace);
+        if (s != nullptr)
+            targets.push_back(s);
     }
-
-    s->resize_active_column(step);
+    return targets;
 }
 
-void ScrollerLayout::cycle_window_width(WORKSPACEID workspace, int step)
+void ScrollerLayout::cycle_window_size(WORKSPACEID workspace, int step, bool selection)
 {
-    auto s = getRowForWorkspace(workspace);
-    if (s == nullptr) {
-        return;
+    for (auto s : get_target_rows(workspace, selection)) {
+        if (selection) {
+            s->resize_selection(step);
+            s->post_event("resize");
+        } else {
+            s->resize_active_column(step);
+        }
     }
-
-    Mode mode = s->get_mode();
-    s->set_mode(Mode::Row, true);
-    s->resize_active_column(step);
-    s->set_mode(mode, true);
 }
 
-void ScrollerLayout::cycle_window_height(WORKSPACEID workspace, int step)
+void ScrollerLayout::cycle_window_width(WORKSPACEID workspace, int step, bool selection)
 {
-    auto s = getRowForWorkspace(workspace);
-    if (s == nullptr) {
-        return;
+    for (auto s : get_target_rows(workspace, selection)) {
+        Mode mode = s->get_mode();
+        s->set_mode(Mode::Row, true);
+        if (selection) {
+            s->resize_selection(step);
+            s->post_event("resize");
+        } else {
+            s->resize_active_column(step);
+        }
+        s->set_mode(mode, true);
     }
-
-    Mode mode = s->get_mode();
-    s->set_mode(Mode::Column, true);
-    s->resize_active_column(step);
-    s->set_mode(mode, true);
 }
 
-void ScrollerLayout::set_window_size(WORKSPACEID workspace, const std::string &arg)
+void ScrollerLayout::cycle_window_height(WORKSPACEID workspace, int step, bool selection)
 {
-    auto s = getRowForWorkspace(workspace);
-    if (s == nullptr) {
-        return;
+    for (auto s : get_target_rows(workspace, selection)) {
+        Mode mode = s->get_mode();
+        s->set_mode(Mode::Column, true);
+        if (selection) {
+            s->resize_selection(step);
+            s->post_event("resize");
+        } else {
+            s->resize_active_column(step);
+        }
+        s->set_mode(mode, true);
     }
-
-    s->size_active_column(arg);
 }
 
-void ScrollerLayout::set_window_width(WORKSPACEID workspace, const std::string &arg)
+void ScrollerLayout::set_window_size(WORKSPACEID workspace, const std::string &arg, bool selection)
 {
-    auto s = getRowForWorkspace(workspace);
-    if (s == nullptr) {
-        return;
+    for (auto s : get_target_rows(workspace, selection)) {
+        if (selection) {
+            s->size_selection(arg);
+            s->post_event("resize");
+        } else {
+            s->size_active_column(arg);
+        }
     }
-
-    Mode mode = s->get_mode();
-    s->set_mode(Mode::Row, true);
-    s->size_active_column(arg);
-    s->set_mode(mode, true);
 }
 
-void ScrollerLayout::set_window_height(WORKSPACEID workspace, const std::string &arg)
+void ScrollerLayout::set_window_width(WORKSPACEID workspace, const std::string &arg, bool selection)
 {
-    auto s = getRowForWorkspace(workspace);
-    if (s == nullptr) {
-        return;
+    for (auto s : get_target_rows(workspace, selection)) {
+        Mode mode = s->get_mode();
+        s->set_mode(Mode::Row, true);
+        if (selection) {
+            s->size_selection(arg);
+            s->post_event("resize");
+        } else {
+            s->size_active_column(arg);
+        }
+        s->set_mode(mode, true);
     }
+}
 
-    Mode mode = s->get_mode();
-    s->set_mode(Mode::Column, true);
-    s->size_active_column(arg);
-    s->set_mode(mode, true);
+void ScrollerLayout::set_window_height(WORKSPACEID workspace, const std::string &arg, bool selection)
+{
+    for (auto s : get_target_rows(workspace, selection)) {
+        Mode mode = s->get_mode();
+        s->set_mode(Mode::Column, true);
+        if (selection) {
+            s->size_selection(arg);
+            s->post_event("resize");
+        } else {
+            s->size_active_column(arg);
+        }
+        s->set_mode(mode, true);
+    }
 }
 
 void ScrollerLayout::move_focus(WORKSPACEID workspace, Direction direction)
@@ -996,41 +1176,52 @@ void ScrollerLayout::set_mode_modifier(WORKSPACEID workspace, const ModeModifier
 }
 
 void ScrollerLayout::fit_size(WORKSPACEID workspace, FitSize fitsize) {
-    auto s = getRowForWorkspace(workspace);
-    if (s == nullptr) {
-        return;
+    bool selection = fitsize == FitSize::Selection;
+    for (auto s : get_target_rows(workspace, selection)) {
+        s->fit_size(fitsize);
+        if (selection)
+            s->post_event("resize");
     }
-    s->fit_size(fitsize);
 }
 
 void ScrollerLayout::fit_width(WORKSPACEID workspace, FitSize fitsize) {
-    auto s = getRowForWorkspace(workspace);
-    if (s == nullptr) {
-        return;
+    bool selection = fitsize == FitSize::Selection;
+    for (auto s : get_target_rows(workspace, selection)) {
+        Mode mode = s->get_mode();
+        s->set_mode(Mode::Row, true);
+        s->fit_size(fitsize);
+        s->set_mode(mode, true);
+        if (selection)
+            s->post_event("resize");
     }
-    Mode mode = s->get_mode();
-    s->set_mode(Mode::Row, true);
-    s->fit_size(fitsize);
-    s->set_mode(mode, true);
 }
 
 void ScrollerLayout::fit_height(WORKSPACEID workspace, FitSize fitsize) {
+    bool selection = fitsize == FitSize::Selection;
+    for (auto s : get_target_rows(workspace, selection)) {
+        Mode mode = s->get_mode();
+        s->set_mode(Mode::Column, true);
+        s->fit_size(fitsize);
+        s->set_mode(mode, true);
+        if (selection)
+            s->post_event("resize");
+    }
+}
+
+void ScrollerLayout::toggle_overview(WORKSPACEID workspace) {
     auto s = getRowForWorkspace(workspace);
     if (s == nullptr) {
         return;
     }
-    Mode mode = s->get_mode();
-    s->set_mode(Mode::Column, true);
-    s->fit_size(fitsize);
-    s->set_mode(mode, true);
+    s->toggle_overview();
 }
 
-void ScrollerLayout::toggle_overview(WORKSPACEID workspace) {
+void ScrollerLayout::toggle_stack(WORKSPACEID workspace) {
     auto s = getRowForWorkspace(workspace);
     if (s == nullptr) {
         return;
     }
-    s->toggle_overview();
+    s->toggle_stack();
 }
 
 PHLWINDOW ScrollerLayout::getActiveWindow(WORKSPACEID workspace) {
@@ -1131,25 +1322,19 @@ void ScrollerLayout::selection_toggle(WORKSPACEID workspace) {
     }
 
     s->selection_toggle();
-
-    // Re-render that monitor to remove decorations
-    g_pHyprRenderer->damageMonitor(g_pCompositor->m_lastMonitor.lock());
 }
 
 void ScrollerLayout::selection_set(PHLWINDOWREF window) {
-    for (auto row = rows.first(); row != nullptr; row = row->next()) {
-        row->data()->selection_set(window);
-    }
+    if (window == nullptr)
+        return;
+    auto s = getRowForWorkspace(window->workspaceID());
+    if (s == nullptr)
+        return;
+    s->selection_set(window);
 }
 
 void ScrollerLayout::selection_reset() {
-    for (auto row = rows.first(); row != nullptr; row = row->next()) {
-        row->data()->selection_reset();
-    }
-    // Re-render windows to remove decorations
-    for (auto monitor : g_pCompositor->m_monitors) {
-        g_pHyprRenderer->damageMonitor(monitor);
-    }
+    scroller_selection.reset();
 }
 
 void ScrollerLayout::selection_workspace(WORKSPACEID workspace) {
@@ -1159,9 +1344,6 @@ void ScrollerLayout::selection_workspace(WORKSPACEID workspace) {
     }
 
     s->selection_all();
-
-    // Re-render that monitor to render decorations
-    g_pHyprRenderer->damageMonitor(g_pCompositor->m_lastMonitor.lock());
 }
 
 // Move all selected columns/windows to workspace, and locate them in direction wrt
@@ -1169,15 +1351,10 @@ void ScrollerLayout::selection_workspace(WORKSPACEID workspace) {
 // defaults to right.
 void ScrollerLayout::selection_move(WORKSPACEID workspace, Direction direction) {
     // Before doing anything complicated, first checkt if there is any selection active
-    bool selection = false;
-    for (auto row = rows.first(); row != nullptr; row = row->next()) {
-        if (row->data()->selection_exists()) {
-            selection = true;
-            break;
-        }
-    }
-    if (!selection)
+    if (scroller_selection.empty())
         return;
+    // Only the rows owning selected windows change
+    std::vector<Row *> owners = get_target_rows(workspace, true);
 
     auto s = getRowForWorkspace(workspace);
     bool overview_on = false;
@@ -1192,30 +1369,33 @@ void ScrollerLayout::selection_move(WORKSPACEID workspace, Direction direction)
     // First modify ScrollerLayout internal structures and then call
     // CWindow::moveToWorkspace(PHLWORKSPACE pWorkspace)
     // for each window, so Hyprland is aware of the changes.
-    List<Column *> columns;
-    auto row = rows.first();
-    while (row != nullptr) {
-        auto next = row->next();
-        if (row->data()->size() > 0) {
-            row->data()->selection_get(s, columns);
+    List<Column *, LayoutHeap> columns;
+    for (auto owner : owners) {
+        if (owner->size() > 0) {
+            owner->selection_get(s, columns);
         }
-        row = next;
     }
 
     s->selection_move(columns, direction);
 
     // Now delete those rows that may have become empty,
     // and recalculate the rest
-    row = rows.first();
+    if (std::find(owners.begin(), owners.end(), s) == owners.end())
+        owners.push_back(s);
+    auto row = rows.first();
     while (row != nullptr) {
         auto next = row->next();
+        if (std::find(owners.begin(), owners.end(), row->data()) == owners.end()) {
+            row = next;
+            continue;
+        }
         if (row->data()->size() == 0) {
-            rows.erase(row);
-            delete row->data();
+            delete_row(row);
         } else {
             bool overview = row->data()->is_overview();
             if (overview)
                 row->data()->toggle_overview();
+            scroller_stats.count(StatsCounter::FocusWindow);
             g_pCompositor->focusWindow(row->data()->get_active_window());
             row->data()->recalculate_row_geometry();
             if (overview)
@@ -1224,6 +1404,7 @@ void ScrollerLayout::selection_move(WORKSPACEID workspace, Direction direction)
         row = next;
     }
 
+    scroller_stats.count(StatsCounter::FocusWindow);
     g_pCompositor->focusWindow(s->get_active_window());
     // Reset selection
     selection_reset();
@@ -1232,38 +1413,105 @@ void ScrollerLayout::selection_move(WORKSPACEID workspace, Direction direction)
         s->toggle_overview();
 }
 
+// Prefix trie of the jump labels. Each node keeps the windows whose labels
+// start with its prefix, so it is easy to hide the ones that stop matching.
+typedef struct {
+    std::vector<int> children;      // node index for each key, -1 if none
+    std::vector<size_t> windows;    // windows under this prefix
+} JumpTrieNode;
+
 typedef struct JumpData {
     typedef struct {
         Row *row;
         bool overview;
+        bool toggled;   // overview turned on by jump
     } Rows;
     PHLWINDOWREF from_window;
     PHLMONITORREF from_monitor;
     std::vector<Rows> workspaces;
     std::vector<PHLWINDOWREF> windows;
     std::vector<JumpDecoration *> decorations;
+    std::vector<std::string> labels;
     std::string keys;
-    int keys_pressed = 0;
-    int nkeys;
-    unsigned int window_number = 0;
+    // Resolved once when jump starts: keysym -> index in keys
+    std::unordered_map<xkb_keysym_t, size_t> keysyms;
+    std::vector<JumpTrieNode> trie;
+    int node = 0;               // current trie node
+    size_t depth = 0;           // keys pressed
     SP<HOOK_CALLBACK_FN> keyPressHookCallback;
 } JumpData;
 
 static JumpData *jump_data;
 
-static std::string generate_label(unsigned int i, const std::string &keys, unsigned int nkeys)
+// Prefix-free labels for n windows. Starting from one key labels, the
+// shortest label is extended with as many keys as needed until there are n,
+// so labels are as short as possible and some may be shorter than others.
+static std::vector<std::string> generate_labels(size_t n, const std::string &keys)
 {
-    size_t ksize = keys.size();
-    std::string label;
-    for (unsigned int n = 0, div = i; n < nkeys; ++n) {
-        unsigned int rem = div % ksize;
-        label.insert(0, &keys[rem], 1);
-        div = div / ksize;
+    std::deque<std::string> labels;
+    for (size_t i = 0; i < keys.size() && labels.size() < n; ++i) {
+        labels.push_back(std::string(1, keys[i]));
+    }
+    while (labels.size() < n) {
+        const std::string prefix = labels.front();
+        labels.pop_front();
+        const size_t children = std::min(keys.size(), n - labels.size());
+        for (size_t i = 0; i < children; ++i) {
+            labels.push_back(prefix + keys[i]);
+        }
     }
-    return label;
+    return std::vector<std::string>(labels.begin(), labels.end());
 }
 
-void ScrollerLayout::jump() {
+static void remove_jump_decoration(size_t i)
+{
+    if (jump_data->decorations[i] == nullptr)
+        return;
+    auto window = jump_data->windows[i].lock();
+    if (window != nullptr)
+        window->removeWindowDeco(jump_data->decorations[i]);
+    jump_data->decorations[i] = nullptr;
+}
+
+static void build_jump_trie(JumpData *data)
+{
+    data->trie.clear();
+    data->trie.push_back({std::vector<int>(data->keys.size(), -1), {}});
+    for (size_t w = 0; w < data->labels.size(); ++w) {
+        int node = 0;
+        data->trie[node].windows.push_back(w);
+        for (auto c : data->labels[w]) {
+            const size_t k = data->keys.find(c);
+            if (data->trie[node].children[k] == -1) {
+                data->trie[node].children[k] = data->trie.size();
+                data->trie.push_back({std::vector<int>(data->keys.size(), -1), {}});
+            }
+            node = data->trie[node].children[k];
+            data->trie[node].windows.push_back(w);
+        }
+    }
+}
+
+// True if the label of the window is on its monitor and not covered by a
+// fullscreen window, so it can be shown without overview
+static bool jump_window_on_screen(PHLWINDOW window)
+{
+    auto monitor = window->m_monitor.lock();
+    if (monitor == nullptr)
+        return false;
+    if (window->m_workspace != nullptr && window->m_workspace->m_hasFullscreenWindow &&
+        !window->isFullscreen())
+        return false;
+    // The label has to be visible, not just some part of the window
+    CBox label = jump_label_box(CBox(window->m_position, window->m_size));
+    if (window->m_workspace != nullptr && !window->m_pinned)
+        label.translate(window->m_workspace->m_renderOffset->value());
+    return label.x >= monitor->m_position.x && label.y >= monitor->m_position.y &&
+           label.x + label.w <= monitor->m_position.x + monitor->m_size.x &&
+           label.y + label.h <= monitor->m_position.y + monitor->m_size.y;
+}
+
+void ScrollerLayout::jump(bool visible_only) {
     if (jumping)
         return;
 
@@ -1279,7 +1527,7 @@ void ScrollerLayout::jump() {
         if (s == nullptr)
             continue;
 
-        jump_data->workspaces.push_back({s, s->is_overview()});
+        jump_data->workspaces.push_back({s, s->is_overview(), false});
     }
     if (jump_data->workspaces.size() == 0) {
         delete jump_data;
@@ -1287,9 +1535,22 @@ void ScrollerLayout::jump() {
         return;
     }
 
-    for (auto workspace : jump_data->workspaces) {
-        workspace.row->get_windows(jump_data->windows);
+    // Overview is only needed for workspaces with labels off screen. Windows
+    // hidden in stacked columns get no label, only their active tab does.
+    for (auto &workspace : jump_data->workspaces) {
+        std::vector<PHLWINDOWREF> windows;
+        workspace.row->get_shown_windows(windows);
+        scroller_allocs.add_vector(AllocSubsystem::Jump, windows);
+        for (auto window : windows) {
+            if (!workspace.overview && !jump_window_on_screen(window.lock())) {
+                if (visible_only)
+                    continue;
+                workspace.toggled = true;
+            }
+            jump_data->windows.push_back(window);
+        }
     }
+    scroller_allocs.add_vector(AllocSubsystem::Jump, jump_data->windows);
     if (jump_data->windows.size() == 0) {
         delete jump_data;
         jumping = false;
@@ -1297,38 +1558,50 @@ void ScrollerLayout::jump() {
     }
 
     static auto const *KEYS = (Hyprlang::STRING const *)HyprlandAPI::getConfigValue(PHANDLE, "plugin:scroller:jump_labels_keys")->getDataStaticPtr();
-    jump_data->keys = *KEYS;
+    // Ignore repeated keys, and those xkb doesn't know
+    for (auto c : std::string(*KEYS)) {
+        if (jump_data->keys.find(c) != std::string::npos)
+            continue;
+        std::string keyname(1, c);
+        xkb_keysym_t key = xkb_keysym_from_name(keyname.c_str(), XKB_KEYSYM_NO_FLAGS);
+        if (!key || jump_data->keysyms.contains(key))
+            continue;
+        jump_data->keysyms[key] = jump_data->keys.size();
+        jump_data->keys.push_back(c);
+    }
     jump_data->from_window = g_pCompositor->m_lastWindow;
     jump_data->from_monitor = g_pCompositor->m_lastMonitor;
 
-    if (jump_data->keys.size() == 1 && jump_data->windows.size() > 1) {
+    if (jump_data->keys.size() == 0 || (jump_data->keys.size() == 1 && jump_data->windows.size() > 1)) {
         delete jump_data;
         jumping = false;
         return;
     }
-    if (jump_data->windows.size() == 1)
-        jump_data->nkeys = 1;
-    else
-        jump_data->nkeys = std::ceil(std::log10(jump_data->windows.size()) / std::log10(jump_data->keys.size()));
+    jump_data->labels = generate_labels(jump_data->windows.size(), jump_data->keys);
+    build_jump_trie(jump_data);
 
-    // Set overview mode for those workspaces that are not
+    // Set overview mode for those workspaces that need it
     for (auto workspace : jump_data->workspaces) {
-        if (!workspace.overview) {
+        if (workspace.toggled) {
             workspace.row->toggle_overview();
         }
     }
 
     // Set decorations (in overview mode)
-    int i = 0;
-    for (auto window : jump_data->windows) {
-        const std::string label = generate_label(i++, jump_data->keys, jump_data->nkeys);
-        auto deco = makeUnique<JumpDecoration>(window.lock(), label);
+    for (size_t i = 0; i < jump_data->windows.size(); ++i) {
+        auto window = jump_data->windows[i].lock();
+        auto deco = makeUnique<JumpDecoration>(window, jump_data->labels[i]);
         jump_data->decorations.push_back(deco.get());
-        HyprlandAPI::addWindowDecoration(PHANDLE, window.lock(), std::move(deco));
+        HyprlandAPI::addWindowDecoration(PHANDLE, window, std::move(deco));
+    }
+    // Render the labels now, so the first frame of jump mode shows all of them
+    g_pHyprOpenGL->makeEGLCurrent();
+    for (size_t i = 0; i < jump_data->windows.size(); ++i) {
+        jump_label_prewarm(jump_data->windows[i].lock(), jump_data->labels[i]);
     }
 
-    jump_data->keys_pressed = 0;
-    jump_data->window_number = 0;
+    jump_data->node = 0;
+    jump_data->depth = 0;
 
     jump_data->keyPressHookCallback = HyprlandAPI::registerCallbackDynamic(PHANDLE, "keyPress", [&](void* /* self */, SCallbackInfo& info, std::any param) {
         auto keypress_event = std::any_cast<std::unordered_map<std::string, std::any>>(param);
@@ -1341,23 +1614,29 @@ void ScrollerLayout::jump() {
         if (event.state != WL_KEYBOARD_KEY_STATE_PRESSED)
             return;
 
-        // Check if key is valid, otherwise exit
-        bool valid = false;
-        for (int i = 0; i < jump_data->keys.size(); ++i) {
-            std::string keyname(1, jump_data->keys[i]);
-            xkb_keysym_t key = xkb_keysym_from_name(keyname.c_str(), XKB_KEYSYM_NO_FLAGS);
-            if (key && key == keysym) {
-                jump_data->window_number = jump_data->window_number * jump_data->keys.size() + i;
-                valid = true;
-                break;
-            }
-        }
+        // Check if key is valid and continues some label, otherwise exit
+        int next = -1;
+        auto key = jump_data->keysyms.find(keysym);
+        if (key != jump_data->keysyms.end())
+            next = jump_data->trie[jump_data->node].children[key->second];
+
         bool focus = false;
-        if (valid) {
-            jump_data->keys_pressed++;
-            if (jump_data->keys_pressed == jump_data->nkeys) {
-                if (jump_data->window_number < jump_data->windows.size())
-                    focus = true;
+        size_t window_number = 0;
+        if (next != -1) {
+            // Hide the labels that don't match anymore
+            for (auto child : jump_data->trie[jump_data->node].children) {
+                if (child == -1 || child == next)
+                    continue;
+                for (auto w : jump_data->trie[child].windows) {
+                    remove_jump_decoration(w);
+                }
+            }
+            jump_data->node = next;
+            jump_data->depth++;
+            const auto &node = jump_data->trie[next];
+            if (node.windows.size() == 1 && jump_data->labels[node.windows[0]].size() == jump_data->depth) {
+                focus = true;
+                window_number = node.windows[0];
             } else {
                 info.cancelled = true;
                 return;
@@ -1366,19 +1645,19 @@ void ScrollerLayout::jump() {
 
         // Finished, remove decorations
         for (size_t i = 0; i < jump_data->windows.size(); ++i) {
-            jump_data->windows[i]->removeWindowDeco(jump_data->decorations[i]);
+            remove_jump_decoration(i);
         }
 
         // Restore original overview
         for (auto workspace : jump_data->workspaces) {
-            if (!workspace.overview) {
+            if (workspace.toggled) {
                 workspace.row->toggle_overview();
             }
         }
         if (focus) {
             update_relative_cursor_coords(jump_data->from_window.lock());
             switch_to_window(jump_data->from_window.lock(),
-                             jump_data->windows[jump_data->window_number].lock());
+                             jump_data->windows[window_number].lock());
         } else {
             if (jump_data->from_window != nullptr)
                 jump_data->from_window->warpCursor();
@@ -1572,3 +1851,99 @@ void ScrollerLayout::mouse_move(SCallbackInfo& info, const Vector2D &mousePos) {
     }
     inside = false;
 }
+
+std::string ScrollerLayout::memory_report(bool json) {
+    struct Entry {
+        const Row *row;
+        RowUsage usage;
+    };
+    std::vector<Entry> entries;
+    for (auto row = rows.first(); row != nullptr; row = row->next()) {
+        Entry entry { .row = row->data() };
+        ++entry.usage.nodes;
+        entry.usage.bytes += sizeof(ListNode<Row *>);
+        row->data()->get_usage(entry.usage);
+        if (overviews != nullptr && overviews->has_data(row->data()->get_workspace())) {
+            ++entry.usage.overview;
+            entry.usage.bytes += sizeof(Overview::OverviewData);
+        }
+        entries.push_back(entry);
+    }
+
+    // Marks, trail marks and overview data that don't belong to any row
+    // should not exist for long: they are what grows without bound.
+    RowUsage unowned;
+    auto usage_for = [&](PHLWINDOW window) -> RowUsage & {
+        if (window != nullptr) {
+            for (auto &entry : entries) {
+                if (entry.row->has_window(window))
+                    return entry.usage;
+            }
+        }
+        return unowned;
+    };
+    marks.for_each([&](const std::string &name, PHLWINDOW window) {
+        auto &usage = usage_for(window);
+        ++usage.marks;
+        usage.bytes += sizeof(std::pair<const std::string, PHLWINDOWREF>) + 2 * sizeof(void *);
+        if (name.capacity() > std::string().capacity())
+            usage.bytes += name.capacity() + 1;
+    });
+    size_t ntrails = 0;
+    if (trails != nullptr) {
+        ntrails = trails->size();
+        trails->for_each_mark([&](PHLWINDOW window) {
+            auto &usage = usage_for(window);
+            ++usage.trail_marks;
+            ++usage.nodes;
+            usage.bytes += sizeof(ListNode<const PHLWINDOWREF>);
+        });
+        unowned.nodes += ntrails;
+        unowned.bytes += ntrails * (sizeof(Trail) + sizeof(ListNode<Trail *>));
+    }
+    if (overviews != nullptr) {
+        size_t owned = 0;
+        for (const auto &entry : entries) {
+            owned += entry.usage.overview;
+        }
+        unowned.overview = overviews->size() - owned;
+        unowned.bytes += unowned.overview * sizeof(Overview::OverviewData);
+    }
+
+    RowUsage total = unowned;
+    for (const auto &entry : entries) {
+        total.add(entry.usage);
+    }
+
+    std::string out;
+    if (json) {
+        auto format_usage = [](const RowUsage &usage) {
+            return std::format("\"columns\": {}, \"windows\": {}, \"nodes\": {}, \"marks\": {}, \"trail_marks\": {}, "
+                               "\"overview\": {}, \"decorations\": {}, \"bytes\": {}",
+                               usage.columns, usage.windows, usage.nodes, usage.marks, usage.trail_marks,
+                               usage.overview, usage.decorations, usage.bytes);
+        };
+        out = "{\"rows\": [";
+        for (size_t i = 0; i < entries.size(); ++i) {
+            out += std::format("{}\n  {{\"workspace\": {}, {}}}", i == 0 ? "" : ",",
+                               entries[i].row->get_workspace(), format_usage(entries[i].usage));
+        }
+        out += std::format("\n], \"unowned\": {{{}}}, \"total\": {{{}}}, \"trails\": {}}}\n",
+                           format_usage(unowned), format_usage(total), ntrails);
+    } else {
+        auto format_usage = [](const std::string &name, const RowUsage &usage) {
+            return std::format("{:<12}{:>9}{:>9}{:>8}{:>8}{:>14}{:>10}{:>13}{:>10}\n", name,
+                               usage.columns, usage.windows, usage.nodes, usage.marks, usage.trail_marks,
+                               usage.overview, usage.decorations, usage.bytes);
+        };
+        out = std::format("{:<12}{:>9}{:>9}{:>8}{:>8}{:>14}{:>10}{:>13}{:>10}\n", "workspace", "columns", "windows",
+                          "nodes", "marks", "trail marks", "overview", "decorations", "bytes");
+        for (const auto &entry : entries) {
+            out += format_usage(std::to_string(entry.row->get_workspace()), entry.usage);
+        }
+        out += format_usage("unowned", unowned);
+        out += format_usage("total", total);
+        out += std::format("\ntrails: {}\n", ntrails);
+    }
+    return out;
+}
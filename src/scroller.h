@@ -4,6 +4,7 @@
 #include <hyprland/src/layout/IHyprLayout.hpp>
 
 #include "list.h"
+#include "allocs.h"
 #include <hyprland/src/SharedDefs.hpp>
 #include <hyprland/src/devices/IPointer.hpp>
 
@@ -41,12 +42,12 @@ public:
     virtual Vector2D predictSizeForNewWindowTiled();
 
     // New Dispatchers
-    void cycle_window_size(WORKSPACEID workspace, int step);
-    void cycle_window_width(WORKSPACEID workspace, int step);
-    void cycle_window_height(WORKSPACEID workspace, int step);
-    void set_window_size(WORKSPACEID workspace, const std::string &arg);
-    void set_window_width(WORKSPACEID workspace, const std::string &arg);
-    void set_window_height(WORKSPACEID workspace, const std::string &arg);
+    void cycle_window_size(WORKSPACEID workspace, int step, bool selection = false);
+    void cycle_window_width(WORKSPACEID workspace, int step, bool selection = false);
+    void cycle_window_height(WORKSPACEID workspace, int step, bool selection = false);
+    void set_window_size(WORKSPACEID workspace, const std::string &arg, bool selection = false);
+    void set_window_width(WORKSPACEID workspace, const std::string &arg, bool selection = false);
+    void set_window_height(WORKSPACEID workspace, const std::string &arg, bool selection = false);
     void move_focus(WORKSPACEID workspace, Direction);
     void move_window(WORKSPACEID workspace, Direction, bool);
     void align_window(WORKSPACEID workspace, Direction);
@@ -58,6 +59,7 @@ public:
     void fit_width(WORKSPACEID workspace, FitSize);
     void fit_height(WORKSPACEID workspace, FitSize);
     void toggle_overview(WORKSPACEID workspace);
+    void toggle_stack(WORKSPACEID workspace);
 
     void marks_add(const std::string &name);
     void marks_delete(const std::string &name);
@@ -82,7 +84,7 @@ public:
     void trailmark_next();
     void trailmark_prev();
 
-    void jump();
+    void jump(bool visible_only = false);
 
     void post_event(WORKSPACEID workspace, const std::string &event);
 
@@ -93,13 +95,18 @@ public:
     void mouse_move(SCallbackInfo& info, const Vector2D &mousePos);
 
     bool is_enabled() const { return enabled; }
+    // Objects of every row, and those that belong to no row
+    std::string memory_report(bool json);
 
 private:
+    void delete_row(ListNode<Row *> *row);
+    void import_windows();
     Row *getRowForWorkspace(WORKSPACEID workspace);
+    std::vector<Row *> get_target_rows(WORKSPACEID workspace, bool selection);
     Row *getRowForWindow(PHLWINDOW window);
     PHLWINDOW getActiveWindow(WORKSPACEID workspace);
 
-    List<Row *> rows;
+    List<Row *, LayoutHeap> rows;
 
     bool enabled;
     Vector2D gesture_delta;
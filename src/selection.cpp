@@ -0,0 +1,32 @@
+#include <hyprland/src/desktop/Window.hpp>
+
+#include "selection.h"
+#include "window.h"
+
+#include <algorithm>
+
+Selection scroller_selection;
+
+std::vector<WORKSPACEID> Selection::workspaces() const
+{
+    std::vector<WORKSPACEID> ids;
+    for (auto window : windows) {
+        auto w = window->get_window();
+        if (w == nullptr)
+            continue;
+        const WORKSPACEID id = w->workspaceID();
+        if (std::find(ids.begin(), ids.end(), id) == ids.end())
+            ids.push_back(id);
+    }
+    return ids;
+}
+
+void Selection::reset()
+{
+    // Deselecting removes the window from the index
+    const std::vector<Window *> selected(windows.begin(), windows.end());
+    for (auto window : selected) {
+        window->selection_reset();
+    }
+    windows.clear();
+}
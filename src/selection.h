@@ -0,0 +1,34 @@
+#ifndef SCROLLER_SELECTION_H
+#define SCROLLER_SELECTION_H
+
+#include <hyprland/src/SharedDefs.hpp>
+
+#include <unordered_set>
+#include <vector>
+
+class Window;
+
+// Layout-wide index of the selected windows, kept up to date by
+// Window::selection_toggle() and ~Window(). The owner of a selected window is
+// the row of its workspace.
+class Selection {
+public:
+    Selection() {}
+    ~Selection() {}
+
+    void add(Window *window) { windows.insert(window); }
+    void remove(Window *window) { windows.erase(window); }
+    bool empty() const { return windows.empty(); }
+    size_t size() const { return windows.size(); }
+    // Workspaces with at least one selected window
+    std::vector<WORKSPACEID> workspaces() const;
+    // Deselects every selected window
+    void reset();
+
+private:
+    std::unordered_set<Window *> windows;
+};
+
+extern Selection scroller_selection;
+
+#endif // SCROLLER_SELECTION_H
@@ -1,4 +1,5 @@
 #include "sizes.h"
+#include "rules.h"
 
 #include <sstream>
 #include <hyprland/src/config/ConfigManager.hpp>
@@ -98,14 +99,19 @@ Mode ScrollerSizes::get_mode(PHLMONITOR monitor)
 
 StandardSize ScrollerSizes::get_window_default_height(PHLWINDOW window)
 {
-    // Check window rules
-    for (auto &r: window->m_matchedRules) {
-        if (r->m_rule.starts_with("plugin:scroller:windowheight")) {
-            const auto window_height = r->m_rule.substr(r->m_rule.find_first_of(' ') + 1);
-            return get_size_from_string(window_height, StandardSize::One);
-        }
-    }
-    const auto monitor = window->m_monitor.lock();
+    // Check window rules, the first one wins
+    std::optional<StandardSize> size;
+    scroller_rules.for_each(window, [&](const ScrollerRule &rule) {
+        if (!size && rule.type == ScrollerRule::Type::WindowHeight)
+            size = rule.size;
+    });
+    if (size)
+        return *size;
+    return get_window_default_height(window->m_monitor.lock());
+}
+
+StandardSize ScrollerSizes::get_window_default_height(PHLMONITOR monitor)
+{
     update();
     for (const auto monitor_data : monitors) {
         if (monitor_data.name == monitor->m_name)
@@ -116,14 +122,19 @@ StandardSize ScrollerSizes::get_window_default_height(PHLWINDOW window)
 
 StandardSize ScrollerSizes::get_column_default_width(PHLWINDOW window)
 {
-    // Check window rules
-    for (auto &r: window->m_matchedRules) {
-        if (r->m_rule.starts_with("plugin:scroller:columnwidth")) {
-            const auto column_width = r->m_rule.substr(r->m_rule.find_first_of(' ') + 1);
-            return get_size_from_string(column_width, StandardSize::OneHalf);
-        }
-    }
-    const auto monitor = window->m_monitor.lock();
+    // Check window rules, the first one wins
+    std::optional<StandardSize> size;
+    scroller_rules.for_each(window, [&](const ScrollerRule &rule) {
+        if (!size && rule.type == ScrollerRule::Type::ColumnWidth)
+            size = rule.size;
+    });
+    if (size)
+        return *size;
+    return get_column_default_width(window->m_monitor.lock());
+}
+
+StandardSize ScrollerSizes::get_column_default_width(PHLMONITOR monitor)
+{
     update();
     for (const auto monitor_data : monitors) {
         if (monitor_data.name == monitor->m_name)
@@ -132,6 +143,38 @@ StandardSize ScrollerSizes::get_column_default_width(PHLWINDOW window)
     return column_default_width;
 }
 
+double ScrollerSizes::get_fraction(StandardSize size)
+{
+    switch (size) {
+    case StandardSize::OneEighth:
+        return 1.0 / 8.0;
+    case StandardSize::OneSixth:
+        return 1.0 / 6.0;
+    case StandardSize::OneFourth:
+        return 1.0 / 4.0;
+    case StandardSize::OneThird:
+        return 1.0 / 3.0;
+    case StandardSize::ThreeEighths:
+        return 3.0 / 8.0;
+    case StandardSize::OneHalf:
+        return 1.0 / 2.0;
+    case StandardSize::FiveEighths:
+        return 5.0 / 8.0;
+    case StandardSize::TwoThirds:
+        return 2.0 / 3.0;
+    case StandardSize::ThreeQuarters:
+        return 3.0 / 4.0;
+    case StandardSize::FiveSixths:
+        return 5.0 / 6.0;
+    case StandardSize::SevenEighths:
+        return 7.0 / 8.0;
+    case StandardSize::One:
+        return 1.0;
+    default:
+        return 0.0;
+    }
+}
+
 StandardSize ScrollerSizes::get_closest_size(const std::vector<StandardSize> &sizes, double fraction, int step) const
 {
     size_t closest = step >= 0 ? sizes.size() - 1 : 0;
@@ -36,6 +36,11 @@ public:
     Mode get_mode(PHLMONITOR monitor);
     StandardSize get_window_default_height(PHLWINDOW window);
     StandardSize get_column_default_width(PHLWINDOW window);
+    // Defaults for a monitor, ignoring window rules
+    StandardSize get_window_default_height(PHLMONITOR monitor);
+    StandardSize get_column_default_width(PHLMONITOR monitor);
+    // Fraction of the monitor taken by a size (0 for Free)
+    static double get_fraction(StandardSize size);
     StandardSize get_window_closest_height(PHLMONITORREF monitor, double fraction, int step);
     StandardSize get_column_closest_width(PHLMONITORREF monitor, double fraction, int step);
     StandardSize get_next_window_height(StandardSize size, int step);
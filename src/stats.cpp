@@ -0,0 +1,201 @@
+#include "stats.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <format>
+#include <iterator>
+
+ScrollerStats scroller_stats;
+
+int Histogram::bucket(uint64_t ns)
+{
+    if (ns < SUBS)
+        return ns;
+    const int e = std::bit_width(ns) - 1;
+    const int sub = (ns >> (e - SUB_BITS)) & (SUBS - 1);
+    return (e - SUB_BITS + 1) * SUBS + sub;
+}
+
+uint64_t Histogram::bucket_max(int index)
+{
+    if (index < SUBS)
+        return index;
+    const int e = index / SUBS + SUB_BITS - 1;
+    const uint64_t sub = index % SUBS;
+    const uint64_t low = (SUBS + sub) << (e - SUB_BITS);
+    return low + (uint64_t(1) << (e - SUB_BITS)) - 1;
+}
+
+void Histogram::add(uint64_t ns)
+{
+    ++buckets[bucket(ns)];
+    ++count;
+    sum += ns;
+    max = std::max(max, ns);
+}
+
+void Histogram::reset()
+{
+    buckets.fill(0);
+    count = 0;
+    sum = 0;
+    max = 0;
+}
+
+uint64_t Histogram::percentile(double p) const
+{
+    if (count == 0)
+        return 0;
+    const uint64_t rank = std::max(uint64_t(1), uint64_t(std::ceil(p * count)));
+    uint64_t seen = 0;
+    for (int i = 0; i < BUCKETS; ++i) {
+        seen += buckets[i];
+        if (seen >= rank)
+            return std::min(bucket_max(i), max);
+    }
+    return max;
+}
+
+StatsOperation *ScrollerStats::get(const std::string &name)
+{
+    for (auto &operation : operations) {
+        if (operation.name == name)
+            return &operation;
+    }
+    operations.push_back(StatsOperation { .name = name });
+    return &operations.back();
+}
+
+void ScrollerStats::reset()
+{
+    for (auto &operation : operations) {
+        operation.latency.reset();
+    }
+}
+
+std::string ScrollerStats::report(bool json) const
+{
+    // Times are reported in microseconds
+    auto us = [](uint64_t ns) { return ns / 1000.0; };
+    std::string out;
+    if (json) {
+        out = "[";
+        for (const auto &operation : operations) {
+            const auto &h = operation.latency;
+            if (h.get_count() == 0)
+                continue;
+            if (out.size() > 1)
+                out += ",";
+            out += std::format("\n  {{\"name\": \"{}\", \"calls\": {}, \"p50\": {:.1f}, \"p99\": {:.1f}, \"max\": {:.1f}, \"total\": {:.1f}}}",
+                               operation.name, h.get_count(), us(h.percentile(0.5)), us(h.percentile(0.99)), us(h.get_max()), us(h.get_sum()));
+        }
+        out += "\n]\n";
+    } else {
+        out = std::format("{:<36}{:>10}{:>12}{:>12}{:>12}\n", "operation", "calls", "p50 (us)", "p99 (us)", "max (us)");
+        for (const auto &operation : operations) {
+            const auto &h = operation.latency;
+            if (h.get_count() == 0)
+                continue;
+            out += std::format("{:<36}{:>10}{:>12.1f}{:>12.1f}{:>12.1f}\n",
+                               operation.name, h.get_count(), us(h.percentile(0.5)), us(h.percentile(0.99)), us(h.get_max()));
+        }
+    }
+    return out;
+}
+
+void ScrollerStats::reset_counters()
+{
+    for (auto &operation : operations) {
+        operation.counters.fill(0);
+    }
+}
+
+std::string ScrollerStats::report_counters(bool json) const
+{
+    static const char *names[] = { "sendWindowSize", "animatedWrite", "warp", "damageMonitor", "damageRegion", "focusWindow",
+                                   "damagedArea" };
+    static_assert(std::size(names) == size_t(StatsCounter::Count));
+
+    auto any = [](const StatsOperation &operation) {
+        return std::any_of(operation.counters.begin(), operation.counters.end(), [](uint64_t c) { return c > 0; });
+    };
+    std::string out;
+    if (json) {
+        out = "[";
+        for (const auto &operation : operations) {
+            if (!any(operation))
+                continue;
+            if (out.size() > 1)
+                out += ",";
+            out += std::format("\n  {{\"name\": \"{}\", \"calls\": {}", operation.name, operation.latency.get_count());
+            for (size_t i = 0; i < std::size(names); ++i) {
+                out += std::format(", \"{}\": {}", names[i], operation.counters[i]);
+            }
+            out += "}";
+        }
+        out += "\n]\n";
+    } else {
+        out = std::format("{:<36}{:>10}", "operation", "calls");
+        for (auto name : names) {
+            out += std::format("{:>16}", name);
+        }
+        out += "\n";
+        for (const auto &operation : operations) {
+            if (!any(operation))
+                continue;
+            out += std::format("{:<36}{:>10}", operation.name, operation.latency.get_count());
+            for (auto c : operation.counters) {
+                out += std::format("{:>16}", c);
+            }
+            out += "\n";
+        }
+    }
+    return out;
+}
+
+std::string ScrollerStats::check_counters()
+{
+    std::string failed;
+    for (auto name : steady_operations) {
+        const StatsOperation *operation = get(name);
+        const uint64_t monitors = operation->counters[size_t(StatsCounter::DamageMonitor)];
+        if (monitors > 0)
+            failed += std::format("{}: {} monitors damaged in full, {} pixels in {} calls\n", name, monitors,
+                                  operation->counters[size_t(StatsCounter::DamagedArea)], operation->latency.get_count());
+    }
+    return failed.empty() ? "ok" : "failed\n" + failed;
+}
+
+void ScrollerStats::reset_allocations()
+{
+    for (auto &operation : operations) {
+        operation.allocations = 0;
+        operation.allocated = 0;
+    }
+}
+
+std::string ScrollerStats::report_allocations(bool json) const
+{
+    std::string out;
+    if (json) {
+        out = "[";
+        for (const auto &operation : operations) {
+            if (operation.allocations == 0)
+                continue;
+            if (out.size() > 1)
+                out += ",";
+            out += std::format("\n  {{\"name\": \"{}\", \"calls\": {}, \"allocations\": {}, \"bytes\": {}}}",
+                               operation.name, operation.latency.get_count(), operation.allocations, operation.allocated);
+        }
+        out += "\n]";
+    } else {
+        out = std::format("{:<36}{:>10}{:>14}{:>14}\n", "operation", "calls", "allocations", "bytes");
+        for (const auto &operation : operations) {
+            if (operation.allocations == 0)
+                continue;
+            out += std::format("{:<36}{:>10}{:>14}{:>14}\n", operation.name, operation.latency.get_count(), operation.allocations, operation.allocated);
+        }
+    }
+    return out;
+}
@@ -0,0 +1,137 @@
+#ifndef SCROLLER_STATS_H
+#define SCROLLER_STATS_H
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <string>
+
+#include "trace.h"
+
+// Latency histogram with log-linear buckets: every power of two of
+// nanoseconds is split in 8 sub-buckets, so percentiles are reported with
+// at most 12.5% error, and adding a sample never allocates.
+class Histogram {
+public:
+    Histogram() { reset(); }
+    ~Histogram() {}
+
+    void add(uint64_t ns);
+    void reset();
+    uint64_t get_count() const { return count; }
+    uint64_t get_max() const { return max; }
+    uint64_t get_sum() const { return sum; }
+    // Upper bound of the bucket holding the sample of rank p (0, 1]
+    uint64_t percentile(double p) const;
+
+private:
+    static constexpr int SUB_BITS = 3;
+    static constexpr int SUBS = 1 << SUB_BITS;
+    static constexpr int BUCKETS = (64 - SUB_BITS + 1) * SUBS;
+
+    static int bucket(uint64_t ns);
+    static uint64_t bucket_max(int index);
+
+    std::array<uint32_t, BUCKETS> buckets;
+    uint64_t count;
+    uint64_t sum;
+    uint64_t max;
+};
+
+// Compositor work the layout triggers
+enum class StatsCounter {
+    SendWindowSize,     // configures sent to clients
+    AnimatedWrite,      // new goals for m_realPosition/m_realSize
+    Warp,               // animated variables warped to their goal
+    DamageMonitor,
+    DamageRegion,
+    FocusWindow,
+    DamagedArea,        // logical pixels repainted on the monitors
+    Count
+};
+
+// Operations that only move existing windows once the layout is built. They
+// should neither allocate nor damage whole monitors.
+inline constexpr const char *steady_operations[] = { "scroller:movefocus", "onWindowFocusChange" };
+
+// A dispatcher or layout callback we keep statistics for
+struct StatsOperation {
+    std::string name;
+    Histogram latency;
+    std::array<uint64_t, size_t(StatsCounter::Count)> counters {};
+    // Heap use, only while ScrollerAllocs is enabled
+    uint64_t allocations = 0;
+    uint64_t allocated = 0;
+};
+
+class ScrollerStats {
+public:
+    ScrollerStats() {}
+    ~ScrollerStats() {}
+
+    // Returns the operation called name, creating it. Operations are never
+    // removed, so callers can keep the pointer.
+    StatsOperation *get(const std::string &name);
+    void reset();
+    std::string report(bool json) const;
+
+    // Side effects are attributed to the outermost operation running, or
+    // to "other" outside of any.
+    StatsOperation *enter(StatsOperation *operation) {
+        StatsOperation *previous = current;
+        if (current == nullptr)
+            current = operation;
+        return previous;
+    }
+    void leave(StatsOperation *previous) { current = previous; }
+    void count(StatsCounter counter, uint64_t n = 1) {
+        (current != nullptr ? current : get_other())->counters[size_t(counter)] += n;
+    }
+    void reset_counters();
+    std::string report_counters(bool json) const;
+    // "ok", or the steady operations that damaged whole monitors since the
+    // last reset
+    std::string check_counters();
+    void count_allocation(uint64_t bytes, uint64_t n = 1) {
+        auto operation = current != nullptr ? current : get_other();
+        operation->allocations += n;
+        operation->allocated += bytes;
+    }
+    void reset_allocations();
+    std::string report_allocations(bool json) const;
+
+private:
+    StatsOperation *get_other() {
+        if (other == nullptr)
+            other = get("other");
+        return other;
+    }
+
+    std::deque<StatsOperation> operations;
+    StatsOperation *current = nullptr;
+    StatsOperation *other = nullptr;
+};
+
+extern ScrollerStats scroller_stats;
+
+// Times the enclosing block as a sample of the operation, and adds it to
+// the trace when tracing is on.
+class StatsScope {
+public:
+    StatsScope(StatsOperation *operation) : operation(operation), previous(scroller_stats.enter(operation)),
+                                            trace(operation->name.c_str()), start(std::chrono::steady_clock::now()) {}
+    ~StatsScope() {
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        operation->latency.add(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        scroller_stats.leave(previous);
+    }
+
+private:
+    StatsOperation *operation;
+    StatsOperation *previous;
+    TraceScope trace;
+    std::chrono::steady_clock::time_point start;
+};
+
+#endif // SCROLLER_STATS_H
@@ -0,0 +1,54 @@
+#include "trace.h"
+
+#include <algorithm>
+#include <format>
+#include <fstream>
+
+ScrollerTrace scroller_trace;
+
+void ScrollerTrace::start(size_t capacity)
+{
+    events.assign(std::max(capacity, size_t(1)), Event {});
+    next = 0;
+    wrapped = false;
+    origin = std::chrono::steady_clock::now();
+    enabled = true;
+}
+
+void ScrollerTrace::add(const char *name, std::chrono::steady_clock::time_point start,
+                        std::chrono::steady_clock::time_point end, uintptr_t id)
+{
+    using std::chrono::duration_cast, std::chrono::nanoseconds;
+    auto &event = events[next];
+    event.name = name;
+    event.start = start > origin ? duration_cast<nanoseconds>(start - origin).count() : 0;
+    event.duration = duration_cast<nanoseconds>(end - start).count();
+    event.id = id;
+    if (++next == events.size()) {
+        next = 0;
+        wrapped = true;
+    }
+}
+
+bool ScrollerTrace::dump(const std::string &path) const
+{
+    std::ofstream out(path);
+    if (!out)
+        return false;
+
+    out << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+    // Oldest event first
+    const size_t count = wrapped ? events.size() : next;
+    const size_t first = wrapped ? next : 0;
+    for (size_t i = 0; i < count; ++i) {
+        const auto &event = events[(first + i) % events.size()];
+        out << (i == 0 ? "\n" : ",\n");
+        out << std::format("{{\"name\": \"{}\", \"ph\": \"X\", \"pid\": 1, \"tid\": 1, \"ts\": {:.3f}, \"dur\": {:.3f}",
+                           event.name, event.start / 1000.0, event.duration / 1000.0);
+        if (event.id != 0)
+            out << std::format(", \"args\": {{\"window\": \"{:x}\"}}", event.id);
+        out << "}";
+    }
+    out << "\n]}\n";
+    return out.good();
+}
@@ -0,0 +1,64 @@
+#ifndef SCROLLER_TRACE_H
+#define SCROLLER_TRACE_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Opt-in timeline of the work done by the layout, saved as Chrome trace JSON
+// (chrome://tracing and ui.perfetto.dev both load it). Hyprland calls the
+// layout from its main thread only, so one ring buffer, allocated when
+// tracing starts, is all it needs. Recording an event only writes a slot,
+// overwriting the oldest one when the buffer is full.
+class ScrollerTrace {
+public:
+    ScrollerTrace() : enabled(false), next(0), wrapped(false) {}
+    ~ScrollerTrace() {}
+
+    bool is_enabled() const { return enabled; }
+    void start(size_t capacity);
+    void stop() { enabled = false; }
+    bool dump(const std::string &path) const;
+    // name must outlive the trace: use literals or StatsOperation names
+    void add(const char *name, std::chrono::steady_clock::time_point start,
+             std::chrono::steady_clock::time_point end, uintptr_t id);
+
+private:
+    struct Event {
+        const char *name;
+        uint64_t start;     // ns since the trace started
+        uint64_t duration;  // ns
+        uintptr_t id;       // window address, or 0
+    };
+
+    bool enabled;
+    std::vector<Event> events;
+    size_t next;
+    bool wrapped;
+    std::chrono::steady_clock::time_point origin;
+};
+
+extern ScrollerTrace scroller_trace;
+
+// Records the enclosing block as a trace event, if tracing is on when the
+// block starts.
+class TraceScope {
+public:
+    TraceScope(const char *name, uintptr_t id = 0) : name(name), id(id), active(scroller_trace.is_enabled()) {
+        if (active)
+            start = std::chrono::steady_clock::now();
+    }
+    ~TraceScope() {
+        if (active && scroller_trace.is_enabled())
+            scroller_trace.add(name, start, std::chrono::steady_clock::now(), id);
+    }
+
+private:
+    const char *name;
+    uintptr_t id;
+    bool active;
+    std::chrono::steady_clock::time_point start;
+};
+
+#endif // SCROLLER_TRACE_H
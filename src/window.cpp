@@ -1,19 +1,154 @@
 #include <hyprland/src/config/ConfigManager.hpp>
 #include <hyprland/src/plugins/PluginAPI.hpp>
+#include <hyprland/src/render/decorations/DecorationPositioner.hpp>
 
 #include "window.h"
+#include "row.h"
 
 extern HANDLE PHANDLE;
 extern ScrollerSizes scroller_sizes;
 
-Window::Window(PHLWINDOW window, double maxy, double box_h, StandardSize width) : window(window), selected(false), width(width)
+bool Window::updating_decoration = false;
+
+Window::Window(PHLWINDOW window, double maxy, double box_h, StandardSize width)
+    : window(window), width(width), selected(false), decoration(nullptr), tabs(nullptr), stack_hidden(false), offscreen(false), stack_box_h(0.0)
 {
     StandardSize h = scroller_sizes.get_window_default_height(window);
     window->m_position.y = maxy;
     update_height(h, box_h);
+}
+
+void Window::get_usage(RowUsage &usage) const
+{
+    ++usage.windows;
+    usage.bytes += sizeof(Window);
+    if (decoration != nullptr) {
+        ++usage.decorations;
+        usage.bytes += sizeof(SelectionBorders);
+    }
+    if (tabs != nullptr) {
+        ++usage.decorations;
+        usage.bytes += sizeof(StackTabs);
+    }
+}
+
+void Window::attach_decoration()
+{
+    if (decoration != nullptr)
+        return;
+    auto w = window.lock();
+    if (w == nullptr)
+        return;
     auto deco = makeUnique<SelectionBorders>(this);
     decoration = deco.get();
-    HyprlandAPI::addWindowDecoration(PHANDLE, window, std::move(deco));
+    updating_decoration = true;
+    HyprlandAPI::addWindowDecoration(PHANDLE, w, std::move(deco));
+    updating_decoration = false;
+    decoration->damageEntire();
+}
+
+void Window::detach_decoration()
+{
+    if (decoration == nullptr)
+        return;
+    auto w = window.lock();
+    if (w != nullptr) {
+        // Repaint the border without the selection color
+        decoration->damageEntire();
+        updating_decoration = true;
+        w->removeWindowDeco(decoration);
+        updating_decoration = false;
+    }
+    decoration = nullptr;
+}
+
+// The tab strip reserves space above the window. Decoration changes ask the
+// layout to recalculate the window, which is ignored while they happen,
+// because set_stacked() is called from the layout pass that positions the
+// window next. Update its reserved area now, so that pass uses it.
+void Window::update_reserved_area(PHLWINDOW w)
+{
+    g_pDecorationPositioner->forceRecalcFor(w);
+    g_pDecorationPositioner->onWindowUpdate(w);
+}
+
+void Window::set_stacked(bool stacked, double max)
+{
+    if (stacked == (tabs != nullptr))
+        return;
+    auto w = window.lock();
+    if (stacked) {
+        if (w == nullptr)
+            return;
+        stack_box_h = box_h;
+        auto deco = makeUnique<StackTabs>(w);
+        tabs = deco.get();
+        updating_decoration = true;
+        HyprlandAPI::addWindowDecoration(PHANDLE, w, std::move(deco));
+        updating_decoration = false;
+        update_reserved_area(w);
+    } else {
+        set_stack_hidden(false);
+        if (w != nullptr) {
+            tabs->damageEntire();
+            updating_decoration = true;
+            w->removeWindowDeco(tabs);
+            updating_decoration = false;
+        }
+        tabs = nullptr;
+        if (w != nullptr)
+            update_reserved_area(w);
+        // Closing windows have nothing to recover
+        if (max > 0.0) {
+            if (height == StandardSize::Free)
+                box_h = stack_box_h;
+            else
+                update_height(height, max);
+        }
+    }
+}
+
+void Window::set_stack_hidden(bool hidden)
+{
+    if (hidden == stack_hidden)
+        return;
+    stack_hidden = hidden;
+    auto w = window.lock();
+    if (w == nullptr || !w->m_isMapped)
+        return;
+    damage_collector.add_window(w);
+    w->setHidden(hidden);
+    // Unhiding resumes the window, keep it suspended if it is far away
+    if (!hidden && offscreen)
+        w->setSuspended(true);
+}
+
+// The compositor resets every suspended state (updateSuspendedStates()) on
+// workspace changes and overview toggles, so check the window, not just the
+// last value set.
+void Window::set_offscreen(bool off)
+{
+    const bool was_offscreen = offscreen;
+    offscreen = off;
+    auto w = window.lock();
+    // Hidden windows in stacked columns are already suspended
+    if (w == nullptr || !w->m_isMapped || stack_hidden)
+        return;
+    if (off) {
+        if (!w->m_suspended)
+            w->setSuspended(true);
+    } else if (was_offscreen) {
+        resume();
+    }
+}
+
+// Gives the window back the suspended state the compositor would give it
+void Window::resume()
+{
+    auto w = window.lock();
+    if (w == nullptr || !w->m_isMapped)
+        return;
+    w->setSuspended(w->isHidden() || w->m_workspace == nullptr || !w->m_workspace->isVisible());
 }
 
 void Window::update_height(StandardSize h, double max)
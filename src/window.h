@@ -4,15 +4,28 @@
 #include "common.h"
 #include "sizes.h"
 #include "decorations.h"
+#include "damage.h"
+#include "selection.h"
+#include "stats.h"
+#include "allocs.h"
 
-class Window {
+struct RowUsage;
+
+class Window : public AllocCounted<AllocSubsystem::Window> {
 public:
     Window(PHLWINDOW window, double maxy, double box_h, StandardSize width);
     ~Window() {
-        window->removeWindowDeco(decoration);
+        if (selected)
+            scroller_selection.remove(this);
+        detach_decoration();
+        set_stacked(false, 0.0);
+        // Windows leaving the layout are not throttled anymore
+        if (offscreen)
+            resume();
     }
     PHLWINDOW get_window() { return window.lock(); }
     double get_geom_h() const { return box_h; }
+    void get_usage(RowUsage &usage) const;
     void set_geom_h(double geom_h) { box_h = geom_h; }
 
     void set_geom_x(double x, const Vector2D &gap_x) {
@@ -60,9 +73,11 @@ public:
     void set_geometry(const Box &box) {
         window->m_position = Vector2D(box.x, box.y);
         window->m_size = Vector2D(box.w, box.h);
+        damage_collector.add_window(window.lock());
         *window->m_realPosition = window->m_position;
         *window->m_realSize = window->m_size;
-        window->sendWindowSize();
+        scroller_stats.count(StatsCounter::AnimatedWrite, 2);
+        send_window_size();
     }
     bool is_window(PHLWINDOW w) const {
         return window == w;
@@ -80,9 +95,11 @@ public:
         window->m_size.x *= scale;
         window->m_size.y = (window->m_size.y + reserved_area.topLeft.y + reserved_area.bottomRight.y + gap0 + gap1) * scale - gap0 - gap1 - reserved_area.topLeft.y - reserved_area.bottomRight.y;
         window->m_size = Vector2D(std::max(window->m_size.x, 1.0), std::max(window->m_size.y, 1.0));
+        damage_collector.add_window(window.lock());
         *window->m_realSize = window->m_size;
         *window->m_realPosition = window->m_position;
-        window->sendWindowSize();
+        scroller_stats.count(StatsCounter::AnimatedWrite, 2);
+        send_window_size();
     }
 
     void move_to_bottom(double x, const Box &max, const Vector2D &gap_x, double gap) {
@@ -108,19 +125,26 @@ public:
 
     void scroll(double delta_y) {
         window->m_position.y += delta_y;
+        damage_collector.add_window(window.lock());
         window->m_realPosition->warp(false);
         *window->m_realPosition = window->m_position;
+        scroller_stats.count(StatsCounter::Warp);
+        scroller_stats.count(StatsCounter::AnimatedWrite);
     }
 
     void update_window(double w, const Vector2D &gap_x, double gap0, double gap1, bool animate) {
         auto reserved = window->getFullWindowReservedArea();
         //win->m_size = Vector2D(w - gap_x.x - gap_x.y, wh - gap0 - gap1);
         window->m_size = Vector2D(std::max(w - reserved.topLeft.x - reserved.bottomRight.x - gap_x.x - gap_x.y, 1.0), std::max(get_geom_h() - reserved.topLeft.y - reserved.bottomRight.y - gap0 - gap1, 1.0));
-        if (!animate)
+        damage_collector.add_window(window.lock());
+        if (!animate) {
             window->m_realPosition->warp(false);
+            scroller_stats.count(StatsCounter::Warp);
+        }
         *window->m_realPosition = window->m_position;
         *window->m_realSize = window->m_size;
-        window->sendWindowSize();
+        scroller_stats.count(StatsCounter::AnimatedWrite, 2);
+        send_window_size();
     }
     bool can_resize_width(double geomw, double maxw, const Vector2D &gap_x, double gap, double deltax) {
         // First, check if resize is possible or it would leave any window
@@ -151,12 +175,22 @@ public:
 
     CGradientValueData get_border_color() const;
 
+    // The selection border is only attached while the window is selected,
+    // so unselected windows don't carry an extra decoration.
     void selection_toggle() {
         selected = !selected;
+        if (selected) {
+            scroller_selection.add(this);
+            attach_decoration();
+        } else {
+            scroller_selection.remove(this);
+            detach_decoration();
+        }
     }
 
     void selection_set() {
-        selected = true;
+        if (!selected)
+            selection_toggle();
     }
 
     void selection_reset() {
@@ -181,7 +215,37 @@ public:
         g_pCompositor->updateWindowAnimatedDecorationValues(window.lock());
     }
 
+    // Windows in stacked columns carry the tab strip, and all but the active
+    // one are hidden (and suspended), so the layout doesn't configure them.
+    void set_stacked(bool stacked, double max);
+    bool is_stacked() const { return tabs != nullptr; }
+    void set_stack_hidden(bool hidden);
+    bool is_stack_hidden() const { return stack_hidden; }
+    // Windows far from the viewport are suspended, so clients stop rendering
+    void set_offscreen(bool offscreen);
+    void set_stack_tabs(const std::vector<PHLWINDOWREF> &windows, size_t active) {
+        if (tabs != nullptr)
+            tabs->set_tabs(windows, active);
+    }
+
+    // Adding or removing a decoration makes Hyprland ask the layout to
+    // recalculate the window. The layout ignores those requests while this is
+    // true: the selection border reserves no space, and the stack tabs update
+    // the reserved area themselves (update_reserved_area()).
+    static bool is_updating_decoration() { return updating_decoration; }
+
 private:
+    void attach_decoration();
+    void detach_decoration();
+    void resume();
+    static void update_reserved_area(PHLWINDOW w);
+    // Every configure the layout sends to the client goes through here
+    void send_window_size() {
+        TraceScope trace("sendWindowSize", reinterpret_cast<uintptr_t>(window.get()));
+        scroller_stats.count(StatsCounter::SendWindowSize);
+        window->sendWindowSize();
+    }
+
     struct Memory {
         double pos_y;
         double box_h;
@@ -202,9 +266,11 @@ private:
         w->m_position.y = mem.pos_y;
         w->m_position = mem.vPosition;
         w->m_size = mem.vSize;
+        damage_collector.add_window(w);
         *w->m_realPosition = w->m_position;
         *w->m_realSize = w->m_size;
-        w->sendWindowSize();
+        scroller_stats.count(StatsCounter::AnimatedWrite, 2);
+        send_window_size();
     }
 
     PHLWINDOWREF window;
@@ -222,6 +288,11 @@ private:
     Memory mem_ov, mem_fs;   // memory to store old height and win y when in overview/fullscreen modes
     bool selected;
     SelectionBorders *decoration;
+    StackTabs *tabs;
+    bool stack_hidden;
+    bool offscreen;
+    double stack_box_h;     // height to recover when leaving a stacked column
+    static bool updating_decoration;
 };
 
 #endif // SCROLLER_WINDOW_H